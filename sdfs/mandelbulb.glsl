@@ -1,4 +1,7 @@
 // Mandelbulb 3D
+// DE Is Marched As Is, Over-Relaxation Backs Off Where It Overestimates
+// @lipschitz 1.0
+// @distanceEstimator 1
 // http://blog.hvidtfeldts.net/index.php/2011/09/distance-estimated-3d-fractals-v-the-mandelbulb-different-de-approximations/
 float sdf(in vec3 p)
 {
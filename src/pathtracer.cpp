@@ -26,21 +26,164 @@
 #include <fstream>
 #include <array>
 #include <cmath>
+#include <sstream>
+#include <future>
+#include <thread>
+#include <random>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 
 const unsigned int WIDTH = 1280;
 const unsigned int HEIGHT = 720;
 const int MAX_FRAMES_IN_FLIGHT = 2;
 const bool OFFSCREENRENDER = false;
+const bool CPURENDER = false; // Renders Offscreen With CPU Port Of Megakernel
 const float MINFRAMETIME = 0.0f;
 const int TONEMAP = 3; // 0 - None,  1 - Reinhard, 2 - ACES Film, 3 - DEUCES
 
 #define DEBUGMODE
 //#define LAUNCHFROMEXECUTABLES
-#define MAX_OBJECTS_SIZE 1024
-#define MAX_SDFS_SIZE 768
-#define MAX_MATERIALS_SIZE 783
-#define MAX_LIGHTS_SIZE 128
-#define MAX_LIGHTIDS_SIZE 64
+#define SCENE_BUFFERS_COUNT 17
+#define WAVEFRONT_BUFFERS_COUNT 2
+#define BVH_LEAF_SIZE 2
+#define BVH_MAX_MIDPOINT_DEPTH 16
+#define BVH_MAX_DEPTH (BVH_STACK_SIZE - 1) // Traversal Holds One Sibling Per Level Plus Both Children Of Deepest Inner Node
+#define SDF_BAKE_BUFFERS_COUNT 4
+#define SDF_BAKE_GRID 16
+#define SDF_BAKE_CELLS 4096
+#define SDF_BRICK_SIZE 8
+#define SDF_BRICK_SAMPLES 512
+#define CONE_TILE_SIZE 8
+#define BLUE_NOISE_SIZE 64
+#define BLUE_NOISE_SIGMA 1.9f
+// Kernel Stages, Same As Shader
+#define STAGE_MEGAKERNEL 0
+#define STAGE_GENERATE 1
+#define STAGE_INTERSECT 2
+#define STAGE_SHADE 3
+#define STAGE_SHADOW 4
+#define STAGE_RESOLVE 5
+#define STAGE_SORT_SCAN 6
+#define STAGE_SORT_SCATTER 7
+#define STAGE_BAKE_CELLS 8
+#define STAGE_BAKE_BRICKS 9
+#define STAGE_CONE_TILES 10
+#define STAGE_ADAPTIVE_COMPACT 11
+#define KERNEL_STAGES_COUNT 12
+#define QUEUE_SHADOW 2
+#define QUEUE_SORTED 3
+#define SORT_BUCKETS_COUNT 64
+#define SDF_REGISTERS_COUNT 32
+#define SDF_MAX_INSTRUCTIONS 65536
+#define SDF_LIPSCHITZ_SAMPLES 4096
+#define SDF_BOUNDS_DEPTH 7
+#define HEIGHTFIELD_MAX_RESOLUTION 4096
+#define HEIGHTFIELD_BAKE_ITERATIONS 8
+#define POLYNOMIAL_MONOMIALS 35
+#define POLYNOMIAL_TERMS 210
+#define CYCLIDE_BOUNDS_DEPTH 6
+#define MARCH_STATS_COUNT 6
+#define CPU_TILE_SIZE 16
+// Adaptive Sampling Starts Once Every Pixel Has Enough Samples For Its Variance, List Of Unconverged Pixels Is Rebuilt Every Few Frames
+#define ADAPTIVE_MIN_SAMPLES 16
+#define ADAPTIVE_UPDATE_FRAMES 8
+// Kernels Timed By Packet Benchmark Of CPU Renderer
+#define PACKET_KERNEL_SPHERE 0
+#define PACKET_KERNEL_PLANE 1
+#define PACKET_KERNEL_BOX 2
+#define PACKET_KERNEL_AABB 3
+#define PACKET_KERNEL_CYCLIDE 4
+#define PACKET_KERNEL_BVH 5
+#define PACKET_KERNEL_ANALYTIC 6
+#define PACKET_KERNEL_COUNT 7
+// Samplers Of Random Numbers, Same As Shader
+#define SAMPLER_PCG32 0
+#define SAMPLER_SOBOL 1
+#define SAMPLER_BLUE_NOISE 2
+#define SAMPLERS_COUNT 3
+#define SAMPLE_DIM_PIXEL 0
+#define SAMPLE_DIM_APERTURE 2
+#define SAMPLE_DIM_WAVELENGTH 4
+#define SAMPLE_DIM_CAMERA_COUNT 6
+#define SAMPLE_DIM_BRDF 0
+#define SAMPLE_DIM_LIGHT_DIRECTION 2
+#define SAMPLE_DIM_LIGHT_CHOICE 4
+#define SAMPLE_DIM_LIGHT_ROULETTE 5
+#define SAMPLE_DIM_ROULETTE 6
+#define SAMPLE_DIM_BOUNCE_COUNT 8
+#define BLUE_NOISE_DIMENSIONS 14
+// Constants Of Megakernel Needed By CPU Renderer, Same As Shader
+#define MAXDIST 1e5f
+#define PI 3.14159265358979f
+#define BVH_STACK_SIZE 32
+#define SDF_SET_SIZE 8
+#define SDF_MARCH_STEPS 512
+#define SDF_MIN_MARCH_STEPS 64
+#define FOOTPRINT_HIT_SCALE 0.25f
+#define FOOTPRINT_BOUNCE_SPREAD 0.01f
+#define HEIGHTFIELD_STEPS_PER_CELL 4
+#define HEIGHTFIELD_NUDGE 1e-3f
+#define SMIN_WIDTH 0.12f
+// SDF Bytecode Opcodes, Same As Shader
+#define SDF_OP_RETURN 0
+#define SDF_OP_JUMP 1
+#define SDF_OP_JUMP_ZERO 2
+#define SDF_OP_CONSTANT 3
+#define SDF_OP_SWIZZLE 4
+#define SDF_OP_INSERT 5
+#define SDF_OP_MOVE 6
+#define SDF_OP_NEGATE 7
+#define SDF_OP_NOT 8
+#define SDF_OP_ADD 9
+#define SDF_OP_SUBTRACT 10
+#define SDF_OP_MULTIPLY 11
+#define SDF_OP_DIVIDE 12
+#define SDF_OP_LESS 13
+#define SDF_OP_LESS_EQUAL 14
+#define SDF_OP_GREATER 15
+#define SDF_OP_GREATER_EQUAL 16
+#define SDF_OP_EQUAL 17
+#define SDF_OP_NOT_EQUAL 18
+#define SDF_OP_AND 19
+#define SDF_OP_OR 20
+#define SDF_OP_SELECT 21
+#define SDF_OP_SIN 22
+#define SDF_OP_COS 23
+#define SDF_OP_TAN 24
+#define SDF_OP_ASIN 25
+#define SDF_OP_ACOS 26
+#define SDF_OP_ATAN 27
+#define SDF_OP_ATAN2 28
+#define SDF_OP_EXP 29
+#define SDF_OP_EXP2 30
+#define SDF_OP_LOG 31
+#define SDF_OP_LOG2 32
+#define SDF_OP_SQRT 33
+#define SDF_OP_INVERSESQRT 34
+#define SDF_OP_POW 35
+#define SDF_OP_ABS 36
+#define SDF_OP_SIGN 37
+#define SDF_OP_FLOOR 38
+#define SDF_OP_CEIL 39
+#define SDF_OP_FRACT 40
+#define SDF_OP_TRUNC 41
+#define SDF_OP_MOD 42
+#define SDF_OP_MIN 43
+#define SDF_OP_MAX 44
+#define SDF_OP_CLAMP 45
+#define SDF_OP_MIX 46
+#define SDF_OP_FMA 47
+#define SDF_OP_STEP 48
+#define SDF_OP_SMOOTHSTEP 49
+#define SDF_OP_DOT 50
+#define SDF_OP_LENGTH 51
+#define SDF_OP_DISTANCE 52
+#define SDF_OP_NORMALIZE 53
+#define SDF_OP_CROSS 54
+#define SDF_OP_SMIN 55
 
 #ifdef DEBUGMODE
 const bool isValidationLayersEnabled = true;
@@ -128,6 +271,15 @@ struct box {
 	int lightID;
 };
 
+// Finite Rectangle Lying In Its Local xz Plane, Size Is Its Width Along x And Depth Along z
+struct rect {
+	float pos[3];
+	float rotation[3];
+	float size[2];
+	int materialID;
+	int lightID;
+};
+
 struct lens {
 	float pos[3];
 	float rotation[3];
@@ -152,12 +304,40 @@ struct cyclide {
 	int lightID;
 };
 
+// Implicit Surface Of Degree Up To 4, Coefficients Follow The Order Of Monomials In PolynomialMonomials()
+struct polynomial {
+	float pos[3];
+	float rotation[3];
+	float scale[3];
+	float coefficients[POLYNOMIAL_MONOMIALS];
+	float brad;
+	int materialID;
+};
+
 struct sdf {
 	float pos[3];
 	float size[3];
 	std::string glsl;
 };
 
+// Grid Of Heights Over The xz Extent Of size, Baked From A glsl Function Like An SDF Or Read From A Raw File
+struct heightfield {
+	float pos[3];
+	float size[3];
+	int resolution;
+	std::string glsl;
+	std::string raw;
+	int materialID;
+};
+
+struct sdfMetadata {
+	float lipschitz;
+	float omegaMax;
+	float omegaSpeed;
+	float hitDistance;
+	bool isDistanceEstimator;
+};
+
 struct material {
 	float reflection[3];
 };
@@ -166,6 +346,30 @@ struct light {
 	float emission[2];
 };
 
+struct bvhNode {
+	float boundsMin[3];
+	int leftFirst;
+	float boundsMax[3];
+	int count;
+};
+
+struct bvhPrimitive {
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+	glm::vec3 centroid;
+	int type;
+	int index;
+};
+
+// Bounding Sphere Of A Light Source While Light BVH Is Built, index Is Its Position In Light IDs
+struct lightEmitter {
+	glm::vec3 pos;
+	float radius;
+	float power;
+	int lightID;
+	int index;
+};
+
 struct Camera {
 	glm::vec3 pos;
 	glm::vec2 angle;
@@ -184,14 +388,198 @@ struct CameraShot {
     glm::vec2 angle;
 };
 
+// Scene Objects As Laid Out In The std430 Storage Buffers Of Shader
+// vec3 Is Aligned To 16 Bytes And Every Struct Is Padded To Its Largest Alignment
+// Material And Light IDs Are Stored Zero Based
+// mat3 Is Laid Out As Three Columns Aligned To 16 Bytes, Which Matches glm::mat3x4
+struct gpuSphere {
+	alignas(16) glm::vec3 pos;
+	float radius;
+	int materialID;
+	int lightID;
+};
+
+struct gpuPlane {
+	alignas(16) glm::vec3 pos;
+	int materialID;
+	int lightID;
+};
+
+struct gpuBox {
+	alignas(16) glm::vec3 pos;
+	float boundingRadius2;
+	alignas(16) glm::mat3x4 worldToLocal;
+	alignas(16) glm::vec3 size;
+	int materialID;
+	int lightID;
+};
+
+struct gpuLens {
+	alignas(16) glm::vec3 pos;
+	float boundingRadius2;
+	alignas(16) glm::mat3x4 worldToLocal;
+	float sliceRadius;
+	float sliceSize;
+	float slicePos;
+	uint32_t isConverging;
+	int materialID;
+	int lightID;
+};
+
+struct gpuCyclide {
+	alignas(16) glm::vec3 pos;
+	float brad;
+	alignas(16) glm::mat3x4 worldToLocal;
+	alignas(16) glm::vec3 invScale;
+	float a;
+	float b;
+	float c;
+	float d;
+	int materialID;
+	int lightID;
+	alignas(16) glm::vec3 boundsMin;
+	alignas(16) glm::vec3 boundsMax;
+};
+
+struct gpuPolynomial {
+	alignas(16) glm::vec3 pos;
+	float boundingRadius2;
+	int materialID;
+	float terms[POLYNOMIAL_TERMS];
+};
+
+struct gpuRect {
+	alignas(16) glm::vec3 pos;
+	float boundingRadius2;
+	alignas(16) glm::mat3x4 worldToLocal;
+	glm::vec2 size;
+	int materialID;
+	int lightID;
+};
+
+struct gpuSDF {
+	alignas(16) glm::vec3 pos;
+	alignas(16) glm::vec3 size;
+	int functionID;
+	int bakeOffset;
+	int codeOffset;
+	int materialCodeOffset;
+	float stepScale;
+	float omegaMax;
+	float omegaSpeed;
+	float hitDistance;
+	int isDistanceEstimator;
+};
+
+struct gpuHeightfield {
+	alignas(16) glm::vec3 pos;
+	int resolution;
+	alignas(16) glm::vec3 size;
+	int levels;
+	int heightOffset;
+	int mipOffset;
+	int materialID;
+};
+
+struct gpuBakeCell {
+	float distance;
+	int brick;
+};
+
+struct gpuMaterial {
+	alignas(16) glm::vec3 reflection;
+};
+
+struct gpuLight {
+	glm::vec2 emission;
+};
+
+struct gpuLightNode {
+	alignas(16) glm::vec3 center;
+	float radius;
+	float power;
+	int leftFirst;
+	int count;
+	int parent;
+};
+
+// Wavefront Path State, Only Its Size Is Used By Host
+struct gpuPathState {
+	alignas(16) glm::vec3 origin;
+	uint32_t seed;
+	alignas(16) glm::vec3 dir;
+	float BRDFpdf;
+	glm::vec4 l;
+	glm::vec4 rayradiance;
+	glm::vec4 radiance;
+	alignas(16) glm::vec3 normal;
+	float hitdist;
+	alignas(16) glm::vec3 shadowOrigin;
+	float materialID;
+	alignas(16) glm::vec3 shadowDir;
+	float lightID;
+	glm::vec4 shadowRadiance;
+	alignas(16) glm::vec3 color;
+	int lightObjectID;
+	int sdfID;
+	int sortKey;
+	alignas(16) glm::vec3 BRDFNormal;
+	int hitObjectID;
+};
+
+// Cone Of Camera Rays Of A Tile Of Pixels, Only Its Size Is Used By Host
+struct gpuConeTile {
+	alignas(16) glm::vec3 apex;
+	float depth;
+	alignas(16) glm::vec3 axis;
+	float cosTheta;
+};
+
+// Header Of Every Wavefront Queue Is Also The Indirect Dispatch Of The Pass Reading It
+struct gpuQueueHeader {
+	VkDispatchIndirectCommand dispatch;
+	uint32_t count;
+};
+
+// Running Color Statistics Of A Pixel, activePixel Of The First Elements Is The List Of Unconverged Pixels
+struct gpuPixelStats {
+	alignas(16) glm::vec3 mean;
+	int frames;
+	alignas(16) glm::vec3 m2;
+	int activePixel;
+};
+
+// Counters Of MarchStatsBuffer, Sphere Tracing And Cyclide Solves Count Every Ray Of A Render So Counters Are 64 Bits
+struct gpuMarchStats {
+	uint64_t marchedRays;
+	uint64_t marchSteps;
+	uint64_t exhaustedRays;
+	uint64_t cyclideTests;
+	uint64_t quarticSolves;
+	uint64_t quarticMisses;
+};
+
+struct StorageBuffer {
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	void* mapped = nullptr;
+	VkDeviceSize size = 0;
+};
+
+struct ComputePipelineBuild {
+	std::array<VkPipeline, KERNEL_STAGES_COUNT> pipelines;
+	std::vector<std::string> functions;
+	std::vector<uint32_t> spirv;
+};
+
 struct UniformBufferObject {
-	float numObjects[7];
-	float packedObjects[MAX_OBJECTS_SIZE];
-	float packedSdfs[MAX_SDFS_SIZE];
-	float packedMaterials[MAX_MATERIALS_SIZE];
-	float packedLights[MAX_LIGHTS_SIZE];
-	float packedLightIDs[MAX_LIGHTIDS_SIZE];
-	float CIEXYZ1931[1323];
+	int numObjects[8];
+	int numMaterials;
+	int numLights;
+	int sdfBVHRoot;
+	int numHeightfields;
+	int numPolynomials;
+	int numRects;
 };
 
 struct PushConstantValues {
@@ -215,6 +603,16 @@ struct PushConstantValues {
 	float lensThickness;
 	float lensDistance;
 	int tonemap;
+	int sampleIndex;
+	int bounce;
+	int isRaySorting;
+	int isCountMarchSteps;
+	int isConePrepass;
+	int isFootprintMarching;
+	int isCyclideIntervalTest;
+	int samplerType;
+	int isAdaptive;
+	float adaptiveThreshold;
 };
 
 const std::vector<const char*> validationLayers = {
@@ -1070,115 +1468,5305 @@ float sRGBCompanding(float x) {
     return x;
 }
 
-class App {
-public:
-    void run() {
-        InitWindow();
-		glslang::InitializeProcess();
-        InitVulkan();
-		if (!OFFSCREENRENDER) {
-			InitImGui();
+// http://www.songho.ca/opengl/gl_anglestoaxes.html
+glm::mat3 RotationMatrix(glm::vec3 angle) {
+	// Builds Rotation Matrix Depending On Given Angle, Same As The One In Shader
+	angle = glm::radians(angle);
+	glm::vec3 sinxyz = glm::sin(angle);
+	glm::vec3 cosxyz = glm::cos(angle);
+	glm::mat3 mX = glm::mat3(1.0f, 0.0f, 0.0f, 0.0f, cosxyz.x, -sinxyz.x, 0.0f, sinxyz.x, cosxyz.x);
+	glm::mat3 mY = glm::mat3(cosxyz.y, 0.0f, sinxyz.y, 0.0f, 1.0f, 0.0f, -sinxyz.y, 0.0f, cosxyz.y);
+	glm::mat3 mZ = glm::mat3(cosxyz.z, -sinxyz.z, 0.0f, sinxyz.z, cosxyz.z, 0.0f, 0.0f, 0.0f, 1.0f);
+	return mX * mY * mZ;
+}
+
+glm::ivec3 MonomialPowers(int index) {
+	// Monomials Up To Degree 4 Sorted By Degree, Then By Descending Powers Of x And y, Same As In Shader
+	int n = 0;
+	for (int degree = 0; degree < 5; degree++) {
+		for (int x = degree; x >= 0; x--) {
+			for (int y = degree - x; y >= 0; y--) {
+				if (n == index) {
+					return glm::ivec3(x, y, degree - x - y);
+				}
+				n++;
+			}
 		}
-        MainLoop();
-		glslang::FinalizeProcess();
-        CleanUp();
-    }
-private:
-    GLFWwindow* window;
-	int W = WIDTH;
-	int H = HEIGHT;
-	bool VSync = false;
+	}
+	return glm::ivec3(-1);
+}
 
-	VkInstance instance;
-	VkDebugUtilsMessengerEXT debugMessenger;
-	VkSurfaceKHR surface;
+int MonomialIndex(glm::ivec3 powers) {
+	// Monomials Of Lower Degree Come Before, Then Those With Higher Power Of x, Then Of y
+	int degree = powers.x + powers.y + powers.z;
+	int rest = degree - powers.x;
+	return (degree * (degree + 1) * (degree + 2)) / 6 + (rest * (rest + 1)) / 2 + powers.z;
+}
 
-	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
-	VkDevice device;
+std::string MonomialName(int index) {
+	// Names Like "x^2yz", Constant Is "1"
+	glm::ivec3 powers = MonomialPowers(index);
+	std::string name;
+	for (int i = 0; i < 3; i++) {
+		if (powers[i] > 0) {
+			name += "xyz"[i];
+		}
+		if (powers[i] > 1) {
+			name += "^" + std::to_string(powers[i]);
+		}
+	}
+	return name.empty() ? "1" : name;
+}
 
-	VkQueue graphicsQueue;
-	VkQueue computeQueue;
-	VkQueue presentQueue;
+int ParseMonomial(const std::string& name) {
+	// Reads Names Written By MonomialName(), Powers Of Repeated Variables Add Up
+	glm::ivec3 powers(0);
+	for (size_t i = 0; (i < name.size()) && (name != "1"); i++) {
+		size_t variable = std::string("xyz").find(name[i]);
+		if (variable == std::string::npos) {
+			throw std::runtime_error("Failed To Parse Polynomial Monomial " + name + "!");
+		}
+		int power = 1;
+		if (((i + 2) < name.size()) && (name[i + 1] == '^') && std::isdigit((unsigned char)name[i + 2])) {
+			power = name[i + 2] - '0';
+			i += 2;
+		}
+		powers[variable] += power;
+	}
+	if ((powers.x + powers.y + powers.z) > 4) {
+		throw std::runtime_error("Failed To Parse Polynomial Monomial " + name + ", Degree Is Above 4!");
+	}
+	return MonomialIndex(powers);
+}
 
-	VkSwapchainKHR swapChain;
-	std::vector<VkImage> swapChainImages;
-	VkFormat swapChainImageFormat;
-	std::vector<VkImageView> swapChainImageViews;
+std::array<double, POLYNOMIAL_MONOMIALS> MultiplyPolynomials(const std::array<double, POLYNOMIAL_MONOMIALS>& a, const std::array<double, POLYNOMIAL_MONOMIALS>& b) {
+	// Terms Above Degree 4 Are Dropped, Substitutions Of Degree 4 Polynomials Never Have Them
+	std::array<double, POLYNOMIAL_MONOMIALS> product{};
+	for (int i = 0; i < POLYNOMIAL_MONOMIALS; i++) {
+		for (int j = 0; (j < POLYNOMIAL_MONOMIALS) && (a[i] != 0.0); j++) {
+			glm::ivec3 powers = MonomialPowers(i) + MonomialPowers(j);
+			if ((b[j] != 0.0) && ((powers.x + powers.y + powers.z) <= 4)) {
+				product[MonomialIndex(powers)] += a[i] * b[j];
+			}
+		}
+	}
+	return product;
+}
 
-	VkRenderPass renderPass;
+void ExpandPolynomialRay(const float coefficients[POLYNOMIAL_MONOMIALS], const glm::mat3& localFromWorld, float terms[POLYNOMIAL_TERMS]) {
+	// Substitutes Local Coordinates Into The Polynomial, Then Weighs Every Pair Of Monomials d^a o^b Of Ray f(o + td)
+	// Coefficient Of t^k Sums Products With |a| = k, Weight Is The Coefficient Of x^(a + b) Times The Binomials Of Its Powers Over a
+	std::array<std::array<double, POLYNOMIAL_MONOMIALS>, 15> linearPowers{};
+	for (int i = 0; i < 3; i++) {
+		std::array<double, POLYNOMIAL_MONOMIALS> linear{};
+		for (int j = 0; j < 3; j++) {
+			linear[1 + j] = localFromWorld[j][i];
+		}
+		linearPowers[5 * i][0] = 1.0;
+		for (int power = 1; power < 5; power++) {
+			linearPowers[5 * i + power] = MultiplyPolynomials(linearPowers[5 * i + power - 1], linear);
+		}
+	}
+	std::array<double, POLYNOMIAL_MONOMIALS> folded{};
+	for (int i = 0; i < POLYNOMIAL_MONOMIALS; i++) {
+		if (coefficients[i] == 0.0f) {
+			continue;
+		}
+		glm::ivec3 powers = MonomialPowers(i);
+		std::array<double, POLYNOMIAL_MONOMIALS> term = MultiplyPolynomials(MultiplyPolynomials(linearPowers[powers.x], linearPowers[5 + powers.y]), linearPowers[10 + powers.z]);
+		for (int j = 0; j < POLYNOMIAL_MONOMIALS; j++) {
+			folded[j] += coefficients[i] * term[j];
+		}
+	}
+	const int monomialsBelow[6] = { 0, 1, 4, 10, 20, 35 };
+	const double binomials[5][5] = { { 1, 0, 0, 0, 0 }, { 1, 1, 0, 0, 0 }, { 1, 2, 1, 0, 0 }, { 1, 3, 3, 1, 0 }, { 1, 4, 6, 4, 1 } };
+	int n = 0;
+	for (int k = 0; k < 5; k++) {
+		for (int i = monomialsBelow[k]; i < monomialsBelow[k + 1]; i++) {
+			for (int j = 0; j < monomialsBelow[5 - k]; j++) {
+				glm::ivec3 a = MonomialPowers(i);
+				glm::ivec3 powers = a + MonomialPowers(j);
+				terms[n] = (float)(folded[MonomialIndex(powers)] * binomials[powers.x][a.x] * binomials[powers.y][a.y] * binomials[powers.z][a.z]);
+				n++;
+			}
+		}
+	}
+}
 
-	VkDescriptorSetLayout descriptorSetLayout;
-	std::vector<VkShaderModule> shaderModules;
+glm::vec2 SquareInterval(const glm::vec2& x) {
+	// Range Of Squares Over Interval, Which Starts At Zero If The Interval Holds It
+	glm::vec2 square = x * x;
+	float squareMin = ((x.x <= 0.0f) && (x.y >= 0.0f)) ? 0.0f : glm::min(square.x, square.y);
+	return glm::vec2(squareMin, glm::max(square.x, square.y));
+}
 
-	VkPipelineLayout graphicsPipelineLayout;
-	VkPipeline graphicsPipeline;
+void GrowCyclideBounds(const cyclide& object, const glm::vec3& center, const glm::vec3& halfSize, int depth, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+	// Cells Inside The Bounds Can't Grow Them, Others Are Empty If Range Of The Equation Over Them Doesn't Hold Zero
+	// Equation: (x^2 + y^2 + z^2 + b^2 - d^2)^2 - 4((ax - cd)^2 + (by)^2), Ranges Are Found By Interval Arithmetic
+	if (glm::all(glm::greaterThanEqual(center - halfSize, boundsMin)) && glm::all(glm::lessThanEqual(center + halfSize, boundsMax))) {
+		return;
+	}
+	glm::vec2 x2 = SquareInterval(glm::vec2(center.x - halfSize.x, center.x + halfSize.x));
+	glm::vec2 y2 = SquareInterval(glm::vec2(center.y - halfSize.y, center.y + halfSize.y));
+	glm::vec2 z2 = SquareInterval(glm::vec2(center.z - halfSize.z, center.z + halfSize.z));
+	glm::vec2 sum2 = SquareInterval(x2 + y2 + z2 + object.b * object.b - object.d * object.d);
+	glm::vec2 ax = object.a * glm::vec2(center.x - halfSize.x, center.x + halfSize.x) - object.c * object.d;
+	glm::vec2 ax2 = SquareInterval(glm::vec2(glm::min(ax.x, ax.y), glm::max(ax.x, ax.y)));
+	float equationMin = sum2.x - 4.0f * (ax2.y + object.b * object.b * y2.y);
+	float equationMax = sum2.y - 4.0f * (ax2.x + object.b * object.b * y2.x);
+	if ((equationMin > 0.0f) || (equationMax < 0.0f)) {
+		return;
+	}
+	if (depth == 0) {
+		boundsMin = glm::min(boundsMin, center - halfSize);
+		boundsMax = glm::max(boundsMax, center + halfSize);
+		return;
+	}
+	for (int i = 0; i < 8; i++) {
+		glm::vec3 octant = glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) - 0.5f;
+		GrowCyclideBounds(object, center + octant * halfSize, 0.5f * halfSize, depth - 1, boundsMin, boundsMax);
+	}
+}
 
-	VkPipelineLayout computePipelineLayout;
-	VkPipeline computePipeline;
+void CyclideLocalBounds(const cyclide& object, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+	// Box Of The Surface In Coordinates Of Its Equation, Which Swap y And z Of Object Coordinates Before Scaling
+	// Only Surface Within The Cube Around Bounding Sphere Is Kept, Whole Cube Is Used If None Is Found
+	boundsMin = glm::vec3(std::numeric_limits<float>::max());
+	boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+	GrowCyclideBounds(object, glm::vec3(0.0f), glm::vec3(object.brad), CYCLIDE_BOUNDS_DEPTH, boundsMin, boundsMax);
+	if (boundsMin.x > boundsMax.x) {
+		boundsMin = glm::vec3(-object.brad);
+		boundsMax = glm::vec3(object.brad);
+	}
+}
 
-	VkCommandPool commandPool;
+struct DualExpression {
+	std::string code;
+	// Type After Rewriting, Empty If It Isn't Known Like For Macros And Global Constants
+	std::string type;
+};
 
-	VkBuffer vertexBuffer;
-	VkDeviceMemory vertexBufferMemory;
-	VkBuffer indexBuffer;
-	VkDeviceMemory indexBufferMemory;
+// Splits GLSL Of An SDF Into Tokens And Finds Its Functions, Everything That Rewrites SDFs On Host Parses Them Through It
+class GLSLTokenizer {
+protected:
+	std::vector<std::string> tokens;
+	size_t position = 0;
+	// Functions With Bodies In The Order They Were Written, Bodies Start At Their Opening Brace
+	std::vector<std::string> functionNames;
+	std::map<std::string, size_t> functionBodies;
+	std::map<std::string, std::string> functionReturnTypes;
+	std::map<std::string, std::vector<std::string>> functionParameters;
+	std::map<std::string, std::vector<std::string>> functionParameterNames;
+	// Everything Else At Global Scope, Like Constants And Function Prototypes
+	std::vector<size_t> globalStatements;
+
+	GLSLTokenizer(const std::string& code) {
+		Tokenize(code);
+		FindFunctions();
+	}
 
-	std::vector<VkBuffer> uniformBuffers;
-	std::vector<VkDeviceMemory> uniformBuffersMemory;
-	std::vector<void*> uniformBuffersMapped;
-	UniformBufferObject ubo;
+public:
+	static std::map<std::string, std::string> FindDefines(const std::string& code) {
+		// Object-Like Macros With Their Values, Function-Like Ones Are Left Out
+		std::map<std::string, std::string> defines;
+		std::istringstream lines(code);
+		std::string line;
+		while (std::getline(lines, line)) {
+			std::istringstream words(line);
+			std::string directive;
+			std::string name;
+			std::string value;
+			words >> directive >> name;
+			if ((directive != "#define") || name.empty() || (name.find('(') != std::string::npos)) {
+				continue;
+			}
+			std::getline(words, value);
+			value.erase(0, value.find_first_not_of(" \t\r"));
+			value.erase(value.find_last_not_of(" \t\r") + 1);
+			defines[name] = value;
+		}
+		return defines;
+	}
 
-	VkBuffer texelBuffer;
-	VkDeviceMemory texelBufferMemory;
-	VkFormat texelBufferFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
-	VkBufferView texelBufferView;
+protected:
+
+	void Tokenize(const std::string& code) {
+		// Comments And Preprocessor Lines Are Dropped
+		const std::string operators[] = {"<<=", ">>=", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "==", "!=", "<=", ">=", "&&", "||", "^^", "<<", ">>"};
+		size_t i = 0;
+		bool isLineStart = true;
+		while (i < code.size()) {
+			char c = code[i];
+			if (c == '\n') {
+				isLineStart = true;
+				i++;
+				continue;
+			}
+			if (std::isspace((unsigned char)c)) {
+				i++;
+				continue;
+			}
+			if ((c == '#') && isLineStart) {
+				while ((i < code.size()) && (code[i] != '\n')) {
+					i += ((code[i] == '\\') && (i + 1 < code.size())) ? 2 : 1;
+				}
+				continue;
+			}
+			isLineStart = false;
+			if (code.compare(i, 2, "//") == 0) {
+				i = code.find('\n', i);
+				i = (i == std::string::npos) ? code.size() : i;
+				continue;
+			}
+			if (code.compare(i, 2, "/*") == 0) {
+				i = code.find("*/", i + 2);
+				i = (i == std::string::npos) ? code.size() : i + 2;
+				continue;
+			}
+			size_t start = i;
+			if (std::isalpha((unsigned char)c) || (c == '_')) {
+				while ((i < code.size()) && (std::isalnum((unsigned char)code[i]) || (code[i] == '_'))) {
+					i++;
+				}
+			} else if (std::isdigit((unsigned char)c) || ((c == '.') && (i + 1 < code.size()) && std::isdigit((unsigned char)code[i + 1]))) {
+				while ((i < code.size()) && (std::isalnum((unsigned char)code[i]) || (code[i] == '.') ||
+				(((code[i] == '+') || (code[i] == '-')) && ((code[i - 1] == 'e') || (code[i - 1] == 'E')) && (code[start] != '0' || code[start + 1] != 'x')))) {
+					i++;
+				}
+			} else {
+				i++;
+				for (const std::string& op : operators) {
+					if (code.compare(start, op.size(), op) == 0) {
+						i = start + op.size();
+						break;
+					}
+				}
+			}
+			tokens.push_back(code.substr(start, i - start));
+		}
+	}
 
-	std::vector<VkFramebuffer> framebuffers;
+	static bool IsIdentifier(const std::string& token) {
+		return !token.empty() && (std::isalpha((unsigned char)token[0]) || (token[0] == '_'));
+	}
 
-	VkDescriptorPool descriptorPool;
-	std::vector<VkDescriptorSet> descriptorSets;
+	static bool IsNumber(const std::string& token) {
+		return !token.empty() && (std::isdigit((unsigned char)token[0]) || ((token[0] == '.') && (token.size() > 1)));
+	}
 
-	PushConstantValues pushConstant;
+	void FindFunctions() {
+		position = 0;
+		while (position < tokens.size()) {
+			size_t start = position;
+			if ((position + 2 < tokens.size()) && IsIdentifier(tokens[position]) && IsIdentifier(tokens[position + 1]) && (tokens[position + 2] == "(")) {
+				std::string returnType = tokens[position];
+				std::string name = tokens[position + 1];
+				position += 3;
+				std::vector<std::string> parameterNames;
+				std::vector<std::string> parameters = ParseParameters(parameterNames);
+				if (Peek() == "{") {
+					functionReturnTypes[name] = returnType;
+					functionParameters[name] = parameters;
+					functionParameterNames[name] = parameterNames;
+					functionBodies[name] = position;
+					functionNames.push_back(name);
+					SkipBlock();
+					continue;
+				}
+			}
+			position = start;
+			globalStatements.push_back(start);
+			SkipStatement();
+		}
+	}
 
-	std::vector<VkCommandBuffer> graphicsCommandBuffers;
-	std::vector<VkCommandBuffer> computeCommandBuffers;
+	std::string Peek(size_t offset = 0) {
+		return (position + offset < tokens.size()) ? tokens[position + offset] : "";
+	}
 
-	std::vector<VkSemaphore> imageAvailableSemaphores;
-	std::vector<VkSemaphore> renderFinishedSemaphores;
-	std::vector<VkFence> inFlightFences;
+	std::string Next() {
+		if (position >= tokens.size()) {
+			throw std::runtime_error("Unexpected End Of SDF");
+		}
+		return tokens[position++];
+	}
 
-	std::vector<VkSemaphore> computeFinishedSemaphores;
-	std::vector<VkFence> computeInFlightFences;
+	bool Accept(const std::string& token) {
+		if (Peek() == token) {
+			position++;
+			return true;
+		}
+		return false;
+	}
 
-	VkDescriptorPool imguiDescriptorPool;
-	ImGuiIO* io;
+	void Expect(const std::string& token) {
+		if (!Accept(token)) {
+			throw std::runtime_error("Expected " + token + " Before " + Peek());
+		}
+	}
 
-	bool isWindowMinimized = false;
-	bool isVSyncChanged = false;
-	bool isCameraLocked = false;
-	bool isReset = false;
-	bool isUpdateUBO = true;
-	bool isRecompile = false;
+	void SkipBlock() {
+		int depth = 0;
+		do {
+			std::string token = Next();
+			depth += (token == "{") ? 1 : ((token == "}") ? -1 : 0);
+		} while (depth > 0);
+	}
 
-	uint32_t currentFrame = 0;
-	int samplesPerFrame = 1;
-	int frame = 0;
-	int currentSamples = 0;
-	int numSamples = 1000;
-	float frameTime = 0.0166f;
-	float minFrameTime = MINFRAMETIME;
-	int cameraShotIndex = 1;
+	void SkipStatement() {
+		while (position < tokens.size()) {
+			if (Peek() == "{") {
+				SkipBlock();
+				Accept(";");
+				return;
+			}
+			if (Next() == ";") {
+				return;
+			}
+		}
+	}
 
-	float persistence = 0.0625f;
-	int pathLength = 5;
-	int tonemap = TONEMAP;
+	std::vector<std::string> ParseParameters(std::vector<std::string>& names) {
+		// Parameters Are Stored As Qualifier And Type, e.g. "inout float", Their Names Go To names
+		std::vector<std::string> parameters;
+		if (Accept(")")) {
+			return parameters;
+		}
+		if ((Peek() == "void") && (Peek(1) == ")")) {
+			position += 2;
+			return parameters;
+		}
+		do {
+			std::string qualifier = "in";
+			std::string token = Next();
+			while ((token == "const") || (token == "in") || (token == "out") || (token == "inout") || (token == "highp") || (token == "mediump") || (token == "lowp")) {
+				qualifier = ((token == "const") || (token == "highp") || (token == "mediump") || (token == "lowp")) ? qualifier : token;
+				token = Next();
+			}
+			parameters.push_back(qualifier + " " + token);
+			names.push_back(Next());
+			if (Peek() == "[") {
+				throw std::runtime_error("Array Parameters Aren't Supported");
+			}
+		} while (Accept(","));
+		Expect(")");
+		return parameters;
+	}
 
+	bool IsDeclaration() {
+		std::string token = Peek();
+		size_t offset = (token == "const") ? 1 : 0;
+		token = Peek(offset);
+		const std::string types[] = {"float", "vec2", "vec3", "vec4", "int", "uint", "bool", "mat2", "mat3", "mat4", "ivec2", "ivec3", "ivec4", "bvec2", "bvec3", "bvec4"};
+		return (std::find(std::begin(types), std::end(types), token) != std::end(types)) && IsIdentifier(Peek(offset + 1));
+	}
 
-	nlohmann::ordered_json scene;
-	bool isLoadScene = false;
-	bool isSaveScene = false;
-	bool isLoadSDF = false;
-	bool isSaveSDF = false;
+	static int Precedence(const std::string& op) {
+		const std::map<std::string, int> precedences = {
+			{"||", 1}, {"^^", 2}, {"&&", 3}, {"|", 4}, {"^", 5}, {"&", 6}, {"==", 7}, {"!=", 7},
+			{"<", 8}, {">", 8}, {"<=", 8}, {">=", 8}, {"<<", 9}, {">>", 9}, {"+", 10}, {"-", 10}, {"*", 11}, {"/", 11}, {"%", 11}
+		};
+		auto it = precedences.find(op);
+		return (it == precedences.end()) ? 0 : it->second;
+	}
+
+};
+
+// Rewrites GLSL Of An SDF Into Dual Numbers, So Gradient Comes Out Of A Single Evaluation
+// Floats And Vectors Become Dual Types, Operators And Built-In Functions Become Calls To Their Dual Versions In Shader
+// Anything It Can't Rewrite Throws, SDF Then Keeps Tetrahedral Normals
+class DualSDFTranslator : public GLSLTokenizer {
+public:
+	DualSDFTranslator(const std::string& code, std::set<std::string>& swizzles) : GLSLTokenizer(code), swizzles(swizzles) {}
+
+	std::string Translate(const std::string& SDFName) {
+		// Rewrites The Functions Reachable From SDFName In The Order They Were Written
+		if (functionBodies.count(SDFName) == 0) {
+			throw std::runtime_error("Function " + SDFName + " Not Found");
+		}
+
+		reachable.insert(SDFName);
+		std::map<std::string, std::string> translated;
+		bool isChanged = true;
+		while (isChanged) {
+			isChanged = false;
+			for (const std::string& name : functionNames) {
+				if ((reachable.count(name) > 0) && (translated.count(name) == 0)) {
+					translated[name] = TranslateFunction(name, functionBodies[name]);
+					isChanged = true;
+				}
+			}
+		}
+
+		std::string code;
+		for (const std::string& name : functionNames) {
+			if (translated.count(name) > 0) {
+				code.append(translated[name]);
+			}
+		}
+		return code;
+	}
+
+	static std::string SwizzleFunctions(const std::set<std::string>& swizzles) {
+		// Every Swizzle Used By Rewritten SDFs Gets A Function For Each Dual Vector Having Its Components
+		const std::string types[] = {"dualFloat", "dualVec2", "dualVec3"};
+		const std::string gradients[] = {"vec3", "mat3x2", "mat3"};
+		std::string code;
+		for (const std::string& swizzle : swizzles) {
+			std::string name = swizzle;
+			std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+			for (int size = 2; size <= 3; size++) {
+				if ((size == 2) && (swizzle.find('z') != std::string::npos)) {
+					continue;
+				}
+				int n = (int)swizzle.size() - 1;
+				code.append(types[n] + " DualSwizzle" + name + "(in " + types[size - 1] + " a) {\n");
+				code.append("    return " + types[n] + "(a.v." + swizzle + ", " + gradients[n] + "(a.g[0]." + swizzle + ", a.g[1]." + swizzle + ", a.g[2]." + swizzle + "));\n");
+				code.append("}\n\n");
+			}
+		}
+		return code;
+	}
+
+private:
+	std::set<std::string>& swizzles;
+	std::set<std::string> reachable;
+	std::map<std::string, std::string> variableTypes;
+	std::string returnType;
+
+	static bool IsDualType(const std::string& type) {
+		return (type == "dualFloat") || (type == "dualVec2") || (type == "dualVec3");
+	}
+
+	static std::string DualType(const std::string& type) {
+		if (type == "float") {
+			return "dualFloat";
+		}
+		if (type == "vec2") {
+			return "dualVec2";
+		}
+		if (type == "vec3") {
+			return "dualVec3";
+		}
+		if ((type == "int") || (type == "uint") || (type == "bool") || (type == "void")) {
+			return type;
+		}
+		throw std::runtime_error("Type " + type + " Isn't Supported");
+	}
+
+	static std::string DualConstructor(const std::string& type) {
+		if (type == "dualFloat") {
+			return "DualFloat";
+		}
+		return (type == "dualVec2") ? "DualVec2" : "DualVec3";
+	}
+
+	std::string TranslateFunction(const std::string& name, size_t body) {
+		// Parameters Are Read Again From The Signature Right Before The Body
+		size_t signature = body;
+		while (tokens[signature] != name) {
+			signature--;
+		}
+		position = signature + 2;
+		variableTypes.clear();
+		returnType = DualType(functionReturnTypes[name]);
+
+		std::string code = returnType + " " + name + "DUAL(";
+		std::vector<std::string> parameters;
+		if (!Accept(")")) {
+			if ((Peek() == "void") && (Peek(1) == ")")) {
+				position += 2;
+			} else {
+				do {
+					std::string qualifier;
+					std::string token = Next();
+					while ((token == "const") || (token == "in") || (token == "out") || (token == "inout") || (token == "highp") || (token == "mediump") || (token == "lowp")) {
+						qualifier = ((token == "const") || (token == "highp") || (token == "mediump") || (token == "lowp")) ? qualifier : token + " ";
+						token = Next();
+					}
+					std::string type = DualType(token);
+					std::string variable = Next();
+					variableTypes[variable] = type;
+					parameters.push_back((qualifier.empty() ? "in " : qualifier) + type + " " + variable);
+				} while (Accept(","));
+				Expect(")");
+			}
+		}
+		for (size_t i = 0; i < parameters.size(); i++) {
+			code.append(((i > 0) ? ", " : "") + parameters[i]);
+		}
+		code.append(") {\n");
+
+		Expect("{");
+		while (!Accept("}")) {
+			code.append(TranslateStatement(1));
+		}
+		code.append("}\n\n");
+		return code;
+	}
+
+	std::string TranslateDeclaration() {
+		// Dual Variables Drop const, So Their Initializers Don't Have To Be Constant Expressions
+		bool isConst = Accept("const");
+		std::string type = DualType(Next());
+		std::string code = (isConst && !IsDualType(type)) ? "const " + type + " " : type + " ";
+		do {
+			std::string variable = Next();
+			if (Peek() == "[") {
+				throw std::runtime_error("Arrays Aren't Supported");
+			}
+			variableTypes[variable] = type;
+			code.append(variable);
+			if (Accept("=")) {
+				code.append(" = " + Convert(type, ParseAssignment()));
+			}
+			if (Peek() == ",") {
+				code.append(", ");
+			}
+		} while (Accept(","));
+		return code;
+	}
+
+	std::string TranslateStatement(int depth) {
+		std::string indent(4 * depth, ' ');
+		std::string token = Peek();
+		if (Accept("{")) {
+			std::string code = indent + "{\n";
+			while (!Accept("}")) {
+				code.append(TranslateStatement(depth + 1));
+			}
+			return code + indent + "}\n";
+		}
+		if (Accept("if")) {
+			Expect("(");
+			std::string code = indent + "if (" + ParseExpression().code + ")\n";
+			Expect(")");
+			code.append(TranslateStatement((Peek() == "{") ? depth : depth + 1));
+			if (Accept("else")) {
+				code.append(indent + "else\n" + TranslateStatement((Peek() == "{") ? depth : depth + 1));
+			}
+			return code;
+		}
+		if (Accept("for")) {
+			Expect("(");
+			std::string code = indent + "for (";
+			if (Peek() != ";") {
+				code.append(IsDeclaration() ? TranslateDeclaration() : ParseExpression().code);
+			}
+			Expect(";");
+			code.append("; ");
+			if (Peek() != ";") {
+				code.append(ParseExpression().code);
+			}
+			Expect(";");
+			code.append("; ");
+			if (Peek() != ")") {
+				code.append(ParseExpression().code);
+			}
+			Expect(")");
+			code.append(")\n");
+			return code + TranslateStatement((Peek() == "{") ? depth : depth + 1);
+		}
+		if (Accept("while")) {
+			Expect("(");
+			std::string code = indent + "while (" + ParseExpression().code + ")\n";
+			Expect(")");
+			return code + TranslateStatement((Peek() == "{") ? depth : depth + 1);
+		}
+		if (Accept("do")) {
+			std::string code = indent + "do\n" + TranslateStatement((Peek() == "{") ? depth : depth + 1);
+			Expect("while");
+			Expect("(");
+			code.append(indent + "while (" + ParseExpression().code + ");\n");
+			Expect(")");
+			Expect(";");
+			return code;
+		}
+		if (Accept("return")) {
+			if (Accept(";")) {
+				return indent + "return;\n";
+			}
+			std::string code = indent + "return " + Convert(returnType, ParseExpression()) + ";\n";
+			Expect(";");
+			return code;
+		}
+		if ((token == "break") || (token == "continue") || (token == "discard")) {
+			position++;
+			Expect(";");
+			return indent + token + ";\n";
+		}
+		if (Accept(";")) {
+			return "";
+		}
+		if ((token == "switch") || (token == "struct")) {
+			throw std::runtime_error(token + " Isn't Supported");
+		}
+		std::string code = indent + (IsDeclaration() ? TranslateDeclaration() : ParseExpression().code) + ";\n";
+		Expect(";");
+		return code;
+	}
+
+	static std::string Promote(const DualExpression& expression) {
+		// Plain Values Become Dual Numbers With Zero Gradient, Integers Are Left As They Are
+		if (IsDualType(expression.type) || (expression.type == "int") || (expression.type == "bool")) {
+			return expression.code;
+		}
+		return "Dual(" + expression.code + ")";
+	}
+
+	static std::string Value(const DualExpression& expression) {
+		if ((expression.type == "int") || (expression.type == "bool") || (expression.type == "float")) {
+			return expression.code;
+		}
+		return "DualValue(" + expression.code + ")";
+	}
+
+	static std::string Convert(const std::string& type, const DualExpression& expression) {
+		if (!IsDualType(type) || (expression.type == type)) {
+			return expression.code;
+		}
+		return DualConstructor(type) + "(" + Promote(expression) + ")";
+	}
+
+	static std::string Widest(const std::string& a, const std::string& b) {
+		// Type Of Arithmetic Between Two Values, Vectors Win Over Floats
+		if ((a == "int") && (b == "int")) {
+			return "int";
+		}
+		if ((a == "dualVec3") || (b == "dualVec3")) {
+			return "dualVec3";
+		}
+		if ((a == "dualVec2") || (b == "dualVec2")) {
+			return "dualVec2";
+		}
+		if ((a.empty() && (b != "float") && (b != "dualFloat")) || (b.empty() && (a != "float") && (a != "dualFloat"))) {
+			return "";
+		}
+		return "dualFloat";
+	}
+
+	DualExpression ParseExpression() {
+		DualExpression expression = ParseAssignment();
+		while (Accept(",")) {
+			DualExpression next = ParseAssignment();
+			expression = {expression.code + ", " + next.code, next.type};
+		}
+		return expression;
+	}
+
+	DualExpression ParseAssignment() {
+		size_t start = position;
+		DualExpression left = ParseConditional();
+		std::string op = Peek();
+		if ((op != "=") && (op != "+=") && (op != "-=") && (op != "*=") && (op != "/=")) {
+			if ((op.size() >= 2) && (op.back() == '=') && (op != "==") && (op != "!=") && (op != "<=") && (op != ">=")) {
+				return {left.code + " " + Next() + " " + ParseAssignment().code, left.type};
+			}
+			return left;
+		}
+		position++;
+		if ((position - 1 != start + 1) || (variableTypes.count(tokens[start]) == 0)) {
+			throw std::runtime_error("Only Assignments To Local Variables Are Supported");
+		}
+		DualExpression right = ParseAssignment();
+		if (!IsDualType(left.type)) {
+			return {left.code + " " + op + " " + right.code, left.type};
+		}
+		if (op != "=") {
+			right = Arithmetic(op.substr(0, 1), left, right);
+		}
+		return {left.code + " = " + Convert(left.type, right), left.type};
+	}
+
+	DualExpression ParseConditional() {
+		DualExpression condition = ParseBinary(1);
+		if (!Accept("?")) {
+			return condition;
+		}
+		DualExpression a = ParseAssignment();
+		Expect(":");
+		DualExpression b = ParseAssignment();
+		if ((a.type == "int") && (b.type == "int")) {
+			return {"(" + condition.code + " ? " + a.code + " : " + b.code + ")", "int"};
+		}
+		return {"DualSelect(" + condition.code + ", " + Promote(a) + ", " + Promote(b) + ")", Widest(a.type, b.type)};
+	}
+
+	DualExpression Arithmetic(const std::string& op, const DualExpression& a, const DualExpression& b) {
+		std::string type = Widest(a.type, b.type);
+		if (type == "int") {
+			return {"(" + a.code + " " + op + " " + b.code + ")", "int"};
+		}
+		const std::map<std::string, std::string> functions = {{"+", "DualAdd"}, {"-", "DualSub"}, {"*", "DualMul"}, {"/", "DualDiv"}};
+		return {functions.at(op) + "(" + Promote(a) + ", " + Promote(b) + ")", type};
+	}
+
+	DualExpression ParseBinary(int minPrecedence) {
+		DualExpression left = ParseUnary();
+		while (true) {
+			std::string op = Peek();
+			int precedence = Precedence(op);
+			if ((precedence == 0) || (precedence < minPrecedence)) {
+				return left;
+			}
+			position++;
+			DualExpression right = ParseBinary(precedence + 1);
+			if ((op == "+") || (op == "-") || (op == "*") || (op == "/")) {
+				left = Arithmetic(op, left, right);
+			} else if (precedence == 7 || precedence == 8) {
+				left = {"(" + Value(left) + " " + op + " " + Value(right) + ")", "bool"};
+			} else {
+				left = {"(" + left.code + " " + op + " " + right.code + ")", ((precedence <= 3) ? "bool" : left.type)};
+			}
+		}
+	}
+
+	DualExpression ParseUnary() {
+		if (Accept("-")) {
+			if (IsNumber(Peek())) {
+				std::string number = Next();
+				return {"-" + number, (number.find_first_of(".eE") != std::string::npos) && (number.find('x') == std::string::npos) ? "float" : "int"};
+			}
+			DualExpression operand = ParseUnary();
+			if (operand.type == "int") {
+				return {"-" + operand.code, "int"};
+			}
+			return {"DualNeg(" + Promote(operand) + ")", operand.type};
+		}
+		if (Accept("+")) {
+			return ParseUnary();
+		}
+		if (Accept("!")) {
+			return {"!" + ParseUnary().code, "bool"};
+		}
+		if ((Peek() == "++") || (Peek() == "--") || (Peek() == "~")) {
+			std::string op = Next();
+			DualExpression operand = ParseUnary();
+			return {op + operand.code, operand.type};
+		}
+		return ParsePostfix();
+	}
+
+	DualExpression ParsePostfix() {
+		DualExpression expression = ParsePrimary();
+		while (true) {
+			if (Accept(".")) {
+				std::string swizzle = Next();
+				if (Peek() == "(") {
+					throw std::runtime_error("Methods Aren't Supported");
+				}
+				for (char& c : swizzle) {
+					size_t index = std::string("rgbstp").find(c);
+					c = (index == std::string::npos) ? c : "xyzxyz"[index];
+				}
+				if ((swizzle.size() > 3) || (swizzle.find_first_not_of("xyz") != std::string::npos)) {
+					throw std::runtime_error("Swizzle " + swizzle + " Isn't Supported");
+				}
+				swizzles.insert(swizzle);
+				std::string name = swizzle;
+				std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+				const std::string types[] = {"dualFloat", "dualVec2", "dualVec3"};
+				expression = {"DualSwizzle" + name + "(" + Promote(expression) + ")", types[swizzle.size() - 1]};
+			} else if ((Peek() == "++") || (Peek() == "--")) {
+				expression.code.append(Next());
+			} else if (Peek() == "[") {
+				throw std::runtime_error("Indexing Isn't Supported");
+			} else {
+				return expression;
+			}
+		}
+	}
+
+	std::vector<DualExpression> ParseArguments() {
+		std::vector<DualExpression> arguments;
+		if (Accept(")")) {
+			return arguments;
+		}
+		do {
+			arguments.push_back(ParseAssignment());
+		} while (Accept(","));
+		Expect(")");
+		return arguments;
+	}
+
+	DualExpression ParsePrimary() {
+		std::string token = Next();
+		if (token == "(") {
+			DualExpression expression = ParseExpression();
+			Expect(")");
+			return {"(" + expression.code + ")", expression.type};
+		}
+		if (IsNumber(token)) {
+			bool isFloat = (token.find_first_of(".eEfF") != std::string::npos) && (token.find('x') == std::string::npos);
+			return {token, isFloat ? "float" : ((token.back() == 'u') || (token.back() == 'U') ? "uint" : "int")};
+		}
+		if ((token == "true") || (token == "false")) {
+			return {token, "bool"};
+		}
+		if (!IsIdentifier(token)) {
+			throw std::runtime_error("Unexpected " + token);
+		}
+		if (!Accept("(")) {
+			auto it = variableTypes.find(token);
+			return {token, (it == variableTypes.end()) ? "" : it->second};
+		}
+
+		std::vector<DualExpression> arguments = ParseArguments();
+		std::string code;
+		for (size_t i = 0; i < arguments.size(); i++) {
+			code.append(((i > 0) ? ", " : "") + Promote(arguments[i]));
+		}
+
+		if ((token == "float") || (token == "vec2") || (token == "vec3")) {
+			std::string type = DualType(token);
+			if ((arguments.size() == 1) && (arguments[0].type == type)) {
+				return arguments[0];
+			}
+			return {DualConstructor(type) + "(" + code + ")", type};
+		}
+		if ((token == "int") || (token == "uint") || (token == "bool")) {
+			if (arguments.size() != 1) {
+				throw std::runtime_error("Constructor " + token + " Isn't Supported");
+			}
+			return {token + "(" + Value(arguments[0]) + ")", token};
+		}
+
+		if (functionParameters.count(token) > 0) {
+			// Functions Of SDF Take Their Dual Parameters Converted, out And inout Ones Need Variables Of The Same Type
+			const std::vector<std::string>& parameters = functionParameters[token];
+			if (parameters.size() != arguments.size()) {
+				throw std::runtime_error("Overloaded Function " + token + " Isn't Supported");
+			}
+			code.clear();
+			for (size_t i = 0; i < arguments.size(); i++) {
+				std::string qualifier = parameters[i].substr(0, parameters[i].find(' '));
+				std::string type = DualType(parameters[i].substr(parameters[i].find(' ') + 1));
+				if ((qualifier != "in") && (arguments[i].type != type)) {
+					throw std::runtime_error("Argument Of " + token + " Must Be A Variable Of Type " + type);
+				}
+				code.append(((i > 0) ? ", " : "") + Convert(type, arguments[i]));
+			}
+			reachable.insert(token);
+			return {token + "DUAL(" + code + ")", DualType(functionReturnTypes[token])};
+		}
+
+		// Built-In Functions With Dual Versions In Shader, Together With The Type Of What They Return
+		const std::map<std::string, std::string> functions = {
+			{"sin", "Sin"}, {"cos", "Cos"}, {"tan", "Tan"}, {"asin", "Asin"}, {"acos", "Acos"}, {"atan", "Atan"},
+			{"exp", "Exp"}, {"exp2", "Exp2"}, {"log", "Log"}, {"log2", "Log2"}, {"sqrt", "Sqrt"}, {"inversesqrt", "Inversesqrt"},
+			{"pow", "Pow"}, {"abs", "Abs"}, {"sign", "Sign"}, {"floor", "Floor"}, {"ceil", "Ceil"}, {"fract", "Fract"},
+			{"mod", "Mod"}, {"min", "Min"}, {"max", "Max"}, {"clamp", "Clamp"}, {"mix", "Mix"}, {"fma", "Fma"},
+			{"step", "Step"}, {"smoothstep", "Smoothstep"}, {"dot", "Dot"}, {"length", "Length"}, {"distance", "Distance"},
+			{"normalize", "Normalize"}, {"cross", "Cross"}, {"smin", "Smin"}
+		};
+		auto it = functions.find(token);
+		if (it == functions.end()) {
+			throw std::runtime_error("Function " + token + " Isn't Supported");
+		}
+		std::string type;
+		if ((token == "dot") || (token == "length") || (token == "distance")) {
+			type = "dualFloat";
+		} else {
+			for (const DualExpression& argument : arguments) {
+				type = type.empty() ? argument.type : Widest(type, argument.type);
+			}
+			type = (type == "float") ? "dualFloat" : type;
+		}
+		// Shader Only Has smin Of float And vec2, Which Return The Type Of Their Arguments
+		if ((token == "smin") && (type == "dualVec3")) {
+			throw std::runtime_error("Function smin Of vec3 Isn't Supported");
+		}
+		return {"Dual" + it->second + "(" + code + ")", type};
+	}
+};
+
+// Register Of SDF Bytecode, Floats Are Kept In Every Component So They Mix With Vectors Component-Wise
+struct SDFValue {
+	int index;
+	// 1 - float, 2 - vec2, 3 - vec3
+	int size;
+	bool isInteger;
+};
+
+// Compiles GLSL Of An SDF Into Bytecode Interpreted By Shader, So SDFs Render Before Pipelines Having Them Are Compiled
+// Calls Are Inlined And Every Variable Gets Its Own Register, Register 0 Holds The Position
+// Anything It Can't Compile Throws, SDF Then Waits For Compiled Pipelines
+class SDFBytecodeCompiler : public GLSLTokenizer {
+public:
+	SDFBytecodeCompiler(const std::string& code, const std::map<std::string, std::string>& shaderDefines) : GLSLTokenizer(code) {
+		// Macros Of SDF Come Before The Ones Of Shader
+		defines = FindDefines(code);
+		defines.insert(shaderDefines.begin(), shaderDefines.end());
+	}
+
+	int Compile(const std::string& functionName, std::vector<glm::ivec4>& code) {
+		// Appends Program Of The Function To code And Returns Where It Starts, Jumps Are Relative To That
+		if (functionBodies.count(functionName) == 0) {
+			throw std::runtime_error("Function " + functionName + " Not Found");
+		}
+		if ((functionParameters[functionName].size() != 1) || (functionParameters[functionName][0] != "in vec3")) {
+			throw std::runtime_error("Function " + functionName + " Must Only Take Position");
+		}
+		program.clear();
+		scopes.assign(1, {});
+		nextRegister = 1;
+		for (size_t statement : globalStatements) {
+			CompileGlobal(statement);
+		}
+
+		scopes.push_back({{functionParameterNames[functionName][0], {0, 3, false}}});
+		position = functionBodies[functionName];
+		CompileStatement();
+		Emit(SDF_OP_RETURN, 0, 1, 0);
+
+		int start = (int)code.size();
+		code.insert(code.end(), program.begin(), program.end());
+		return start;
+	}
+
+private:
+	// Inlined Function Writes Its Result To resultRegister, Its Returns Jump To The End Of Its Body
+	struct InlinedFunction {
+		std::string name;
+		int resultRegister;
+		std::vector<int> returns;
+	};
+
+	struct Loop {
+		std::vector<int> breaks;
+		std::vector<int> continues;
+	};
+
+	std::map<std::string, std::string> defines;
+	std::vector<glm::ivec4> program;
+	std::vector<std::map<std::string, SDFValue>> scopes;
+	std::vector<InlinedFunction> inlined;
+	std::vector<Loop> loops;
+	// Registers Are Used Like A Stack, Values Of Expressions Always End Up At The Bottom Of What They Used
+	int nextRegister = 1;
+
+	int Emit(int op, int destination, int size, int a = 0, int b = 0, int c = 0) {
+		program.push_back(glm::ivec4(op | (destination << 8) | (size << 16), a, b, c));
+		return (int)program.size() - 1;
+	}
+
+	void Patch(int instruction, int target) {
+		// Target Of Jump Is In y, Except Conditional Jump Which Keeps Its Condition There
+		if ((program[instruction].x & 255) == SDF_OP_JUMP_ZERO) {
+			program[instruction].z = target;
+		} else {
+			program[instruction].y = target;
+		}
+	}
+
+	int Allocate() {
+		if (nextRegister >= SDF_REGISTERS_COUNT) {
+			throw std::runtime_error("SDF Needs More Than " + std::to_string(SDF_REGISTERS_COUNT) + " Registers");
+		}
+		return nextRegister++;
+	}
+
+	SDFValue Result(int mark, int size, bool isInteger) {
+		// Value Computed From Operands Above mark Replaces Them
+		nextRegister = mark;
+		Allocate();
+		return {mark, size, isInteger};
+	}
+
+	SDFValue Constant(float x, bool isInteger) {
+		int index = Allocate();
+		glm::ivec3 bits = glm::floatBitsToInt(glm::vec3(x));
+		program.push_back(glm::ivec4(SDF_OP_CONSTANT | (index << 8) | (1 << 16), bits.x, bits.y, bits.z));
+		return {index, 1, isInteger};
+	}
+
+	static SDFValue Type(const std::string& type) {
+		if (type == "float") {
+			return {0, 1, false};
+		}
+		if (type == "vec2") {
+			return {0, 2, false};
+		}
+		if (type == "vec3") {
+			return {0, 3, false};
+		}
+		if ((type == "int") || (type == "uint") || (type == "bool")) {
+			return {0, 1, true};
+		}
+		throw std::runtime_error("Type " + type + " Isn't Supported");
+	}
+
+	SDFValue* FindVariable(const std::string& name) {
+		for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++) {
+			auto it = scope->find(name);
+			if (it != scope->end()) {
+				return &it->second;
+			}
+		}
+		return nullptr;
+	}
+
+	SDFValue Variable(const std::string& name) {
+		SDFValue* variable = FindVariable(name);
+		if (variable == nullptr) {
+			throw std::runtime_error("Variable " + name + " Not Found");
+		}
+		return *variable;
+	}
+
+	void CompileGlobal(size_t statement) {
+		// Global Constants Are Computed At The Start Of Every Program, Prototypes Are Skipped
+		position = statement;
+		if ((Peek() == "precision") || (IsDeclaration() && (Peek(((Peek() == "const") ? 1 : 0) + 2) == "("))) {
+			return;
+		}
+		if (!IsDeclaration()) {
+			throw std::runtime_error("Global " + Peek() + " Isn't Supported");
+		}
+		CompileDeclaration();
+		Expect(";");
+	}
+
+	void CompileDeclaration() {
+		Accept("const");
+		SDFValue type = Type(Next());
+		do {
+			std::string name = Next();
+			if (Peek() == "[") {
+				throw std::runtime_error("Arrays Aren't Supported");
+			}
+			int mark = nextRegister;
+			int index = mark;
+			if (Accept("=")) {
+				SDFValue value = ParseAssignment();
+				nextRegister = mark;
+				Allocate();
+				if (value.index != mark) {
+					Emit(SDF_OP_MOVE, mark, type.size, value.index);
+				}
+			} else {
+				Allocate();
+			}
+			scopes.back()[name] = {index, type.size, type.isInteger};
+		} while (Accept(","));
+	}
+
+	void CompileScopedStatement() {
+		int mark = nextRegister;
+		scopes.push_back({});
+		CompileStatement();
+		scopes.pop_back();
+		nextRegister = mark;
+	}
+
+	int CompileCondition(int mark) {
+		// Jumps Past What Follows When Condition Is False, Caller Patches Where
+		SDFValue condition = ParseExpression();
+		nextRegister = mark;
+		return Emit(SDF_OP_JUMP_ZERO, 0, 1, condition.index);
+	}
+
+	void CompileLoopEnd(int continueTarget, int exit) {
+		Loop loop = loops.back();
+		loops.pop_back();
+		for (int instruction : loop.continues) {
+			Patch(instruction, continueTarget);
+		}
+		for (int instruction : loop.breaks) {
+			Patch(instruction, (int)program.size());
+		}
+		if (exit >= 0) {
+			Patch(exit, (int)program.size());
+		}
+	}
+
+	void CompileStatement() {
+		int mark = nextRegister;
+		std::string token = Peek();
+		if (Accept("{")) {
+			scopes.push_back({});
+			while (!Accept("}")) {
+				CompileStatement();
+			}
+			scopes.pop_back();
+			nextRegister = mark;
+			return;
+		}
+		if (Accept("if")) {
+			Expect("(");
+			int skip = CompileCondition(mark);
+			Expect(")");
+			CompileScopedStatement();
+			if (Accept("else")) {
+				int end = Emit(SDF_OP_JUMP, 0, 0);
+				Patch(skip, (int)program.size());
+				CompileScopedStatement();
+				Patch(end, (int)program.size());
+			} else {
+				Patch(skip, (int)program.size());
+			}
+			return;
+		}
+		if (Accept("for")) {
+			// Step Is Compiled After The Body, So Its Tokens Are Skipped Until Then
+			Expect("(");
+			scopes.push_back({});
+			if (IsDeclaration()) {
+				CompileDeclaration();
+			} else if (Peek() != ";") {
+				ParseExpression();
+				nextRegister = mark;
+			}
+			Expect(";");
+			int loopMark = nextRegister;
+			int condition = (int)program.size();
+			int exit = -1;
+			if (Peek() != ";") {
+				exit = CompileCondition(loopMark);
+			}
+			Expect(";");
+			size_t step = position;
+			for (int depth = 0; (depth > 0) || (Peek() != ")"); ) {
+				std::string stepToken = Next();
+				depth += (stepToken == "(") ? 1 : ((stepToken == ")") ? -1 : 0);
+			}
+			Expect(")");
+			loops.push_back({});
+			CompileScopedStatement();
+			int continueTarget = (int)program.size();
+			size_t end = position;
+			position = step;
+			if (Peek() != ")") {
+				ParseExpression();
+				nextRegister = loopMark;
+			}
+			position = end;
+			Emit(SDF_OP_JUMP, 0, 0, condition);
+			CompileLoopEnd(continueTarget, exit);
+			scopes.pop_back();
+			nextRegister = mark;
+			return;
+		}
+		if (Accept("while")) {
+			Expect("(");
+			int condition = (int)program.size();
+			int exit = CompileCondition(mark);
+			Expect(")");
+			loops.push_back({});
+			CompileScopedStatement();
+			Emit(SDF_OP_JUMP, 0, 0, condition);
+			CompileLoopEnd(condition, exit);
+			return;
+		}
+		if (Accept("do")) {
+			int start = (int)program.size();
+			loops.push_back({});
+			CompileScopedStatement();
+			Expect("while");
+			Expect("(");
+			int condition = (int)program.size();
+			int exit = CompileCondition(mark);
+			Expect(")");
+			Expect(";");
+			Emit(SDF_OP_JUMP, 0, 0, start);
+			CompileLoopEnd(condition, exit);
+			return;
+		}
+		if (Accept("return")) {
+			SDFValue value = {0, 1, false};
+			if (!Accept(";")) {
+				value = ParseExpression();
+				Expect(";");
+			}
+			if (inlined.empty()) {
+				Emit(SDF_OP_RETURN, 0, 1, value.index);
+			} else {
+				Emit(SDF_OP_MOVE, inlined.back().resultRegister, value.size, value.index);
+				inlined.back().returns.push_back(Emit(SDF_OP_JUMP, 0, 0));
+			}
+			nextRegister = mark;
+			return;
+		}
+		if ((token == "break") || (token == "continue")) {
+			position++;
+			Expect(";");
+			if (loops.empty()) {
+				throw std::runtime_error(token + " Outside Of Loop");
+			}
+			std::vector<int>& jumps = (token == "break") ? loops.back().breaks : loops.back().continues;
+			jumps.push_back(Emit(SDF_OP_JUMP, 0, 0));
+			return;
+		}
+		if (Accept(";")) {
+			return;
+		}
+		if ((token == "switch") || (token == "struct") || (token == "discard")) {
+			throw std::runtime_error(token + " Isn't Supported");
+		}
+		if (IsDeclaration()) {
+			CompileDeclaration();
+		} else {
+			ParseExpression();
+			nextRegister = mark;
+		}
+		Expect(";");
+	}
+
+	SDFValue ParseExpression() {
+		int mark = nextRegister;
+		SDFValue value = ParseAssignment();
+		while (Accept(",")) {
+			nextRegister = mark;
+			value = ParseAssignment();
+		}
+		return value;
+	}
+
+	static bool IsAssignment(const std::string& op) {
+		return (op == "=") || (op == "+=") || (op == "-=") || (op == "*=") || (op == "/=");
+	}
+
+	std::vector<int> SwizzleComponents(std::string swizzle, int size) {
+		std::vector<int> components;
+		for (char c : swizzle) {
+			size_t component = std::string("xyzrgbstp").find(c);
+			if ((component == std::string::npos) || ((int)(component % 3) >= size) || (swizzle.size() > 3)) {
+				throw std::runtime_error("Swizzle " + swizzle + " Isn't Supported");
+			}
+			components.push_back((int)(component % 3));
+		}
+		return components;
+	}
+
+	SDFValue ParseAssignment() {
+		// Only Variables And Their Swizzles Can Be Assigned To
+		std::string name = Peek();
+		bool isSwizzle = (Peek(1) == ".") && IsAssignment(Peek(3));
+		if (!IsIdentifier(name) || (FindVariable(name) == nullptr) || (!IsAssignment(Peek(1)) && !isSwizzle)) {
+			return ParseConditional();
+		}
+		int mark = nextRegister;
+		SDFValue variable = Variable(name);
+		position++;
+		std::vector<int> components;
+		if (isSwizzle) {
+			position++;
+			components = SwizzleComponents(Next(), variable.size);
+		}
+		std::string op = Next();
+		SDFValue value = ParseAssignment();
+		if (!isSwizzle) {
+			if (op != "=") {
+				Arithmetic(op.substr(0, 1), variable, value, variable.index);
+			} else if (value.index != variable.index) {
+				Emit(SDF_OP_MOVE, variable.index, variable.size, value.index);
+			}
+			nextRegister = mark;
+			return variable;
+		}
+		if (op != "=") {
+			SDFValue current = Swizzle(variable, components, nextRegister);
+			value = Arithmetic(op.substr(0, 1), current, value, current.index);
+		}
+		for (size_t i = 0; i < components.size(); i++) {
+			Emit(SDF_OP_INSERT, variable.index, variable.size, value.index, ((value.size == 1) ? 0 : (int)i) | (components[i] << 2));
+		}
+		nextRegister = mark;
+		return variable;
+	}
+
+	SDFValue ParseConditional() {
+		int mark = nextRegister;
+		SDFValue condition = ParseBinary(1);
+		if (!Accept("?")) {
+			return condition;
+		}
+		SDFValue a = ParseAssignment();
+		Expect(":");
+		SDFValue b = ParseAssignment();
+		Emit(SDF_OP_SELECT, mark, std::max(a.size, b.size), condition.index, a.index, b.index);
+		return Result(mark, std::max(a.size, b.size), a.isInteger && b.isInteger);
+	}
+
+	SDFValue Arithmetic(const std::string& op, const SDFValue& a, const SDFValue& b, int destination) {
+		const std::map<std::string, int> opcodes = {
+			{"+", SDF_OP_ADD}, {"-", SDF_OP_SUBTRACT}, {"*", SDF_OP_MULTIPLY}, {"/", SDF_OP_DIVIDE}, {"%", SDF_OP_MOD},
+			{"<", SDF_OP_LESS}, {"<=", SDF_OP_LESS_EQUAL}, {">", SDF_OP_GREATER}, {">=", SDF_OP_GREATER_EQUAL},
+			{"==", SDF_OP_EQUAL}, {"!=", SDF_OP_NOT_EQUAL}, {"&&", SDF_OP_AND}, {"||", SDF_OP_OR}
+		};
+		auto it = opcodes.find(op);
+		if (it == opcodes.end()) {
+			throw std::runtime_error("Operator " + op + " Isn't Supported");
+		}
+		int size = std::max(a.size, b.size);
+		bool isInteger = a.isInteger && b.isInteger;
+		Emit(it->second, destination, size, a.index, b.index);
+		// Integers Live In Floats, Their Division Drops The Fraction
+		if ((op == "/") && isInteger) {
+			Emit(SDF_OP_TRUNC, destination, size, destination);
+		}
+		bool isComparison = (Precedence(op) <= 8);
+		return {destination, isComparison ? 1 : size, isComparison || isInteger};
+	}
+
+	SDFValue ParseBinary(int minPrecedence) {
+		int mark = nextRegister;
+		SDFValue left = ParseUnary();
+		while (true) {
+			std::string op = Peek();
+			int precedence = Precedence(op);
+			if ((precedence == 0) || (precedence < minPrecedence)) {
+				return left;
+			}
+			position++;
+			SDFValue right = ParseBinary(precedence + 1);
+			left = Arithmetic(op, left, right, mark);
+			Result(mark, left.size, left.isInteger);
+		}
+	}
+
+	SDFValue ParseUnary() {
+		int mark = nextRegister;
+		if (Accept("-")) {
+			if (IsNumber(Peek())) {
+				SDFValue number = ParsePrimary();
+				program.back().y ^= INT32_MIN;
+				program.back().z ^= INT32_MIN;
+				program.back().w ^= INT32_MIN;
+				return number;
+			}
+			SDFValue operand = ParseUnary();
+			Emit(SDF_OP_NEGATE, mark, operand.size, operand.index);
+			return Result(mark, operand.size, operand.isInteger);
+		}
+		if (Accept("+")) {
+			return ParseUnary();
+		}
+		if (Accept("!")) {
+			SDFValue operand = ParseUnary();
+			Emit(SDF_OP_NOT, mark, 1, operand.index);
+			return Result(mark, 1, true);
+		}
+		if ((Peek() == "++") || (Peek() == "--")) {
+			std::string op = Next();
+			SDFValue variable = Variable(Next());
+			SDFValue one = Constant(1.0f, true);
+			Emit((op == "++") ? SDF_OP_ADD : SDF_OP_SUBTRACT, variable.index, variable.size, variable.index, one.index);
+			nextRegister = mark;
+			return variable;
+		}
+		return ParsePostfix();
+	}
+
+	SDFValue Swizzle(const SDFValue& value, const std::vector<int>& components, int destination) {
+		// Missing Components Read As Zero, Single Component Is Spread Over Every Component
+		int pattern = 0;
+		for (int i = 0; i < 3; i++) {
+			int component = (components.size() == 1) ? components[0] : ((i < (int)components.size()) ? components[i] : 3);
+			pattern |= component << (2 * i);
+		}
+		Emit(SDF_OP_SWIZZLE, destination, (int)components.size(), value.index, pattern);
+		return Result(destination, (int)components.size(), value.isInteger);
+	}
+
+	SDFValue ParsePostfix() {
+		int mark = nextRegister;
+		SDFValue value = ParsePrimary();
+		while (true) {
+			if (Accept(".")) {
+				std::string swizzle = Next();
+				if (Peek() == "(") {
+					throw std::runtime_error("Methods Aren't Supported");
+				}
+				value = Swizzle(value, SwizzleComponents(swizzle, value.size), mark);
+			} else if (Peek() == "[") {
+				throw std::runtime_error("Indexing Isn't Supported");
+			} else {
+				return value;
+			}
+		}
+	}
+
+	std::vector<SDFValue> ParseArguments() {
+		std::vector<SDFValue> arguments;
+		if (Accept(")")) {
+			return arguments;
+		}
+		do {
+			arguments.push_back(ParseAssignment());
+		} while (Accept(","));
+		Expect(")");
+		return arguments;
+	}
+
+	SDFValue ParseNumber(const std::string& token) {
+		std::string number = token;
+		while (!number.empty() && ((number.back() == 'f') || (number.back() == 'F') || (number.back() == 'u') || (number.back() == 'U'))) {
+			number.pop_back();
+		}
+		bool isHexadecimal = (number.size() > 1) && ((number[1] == 'x') || (number[1] == 'X'));
+		bool isInteger = isHexadecimal || (number.find_first_of(".eE") == std::string::npos);
+		try {
+			return Constant(isInteger ? (float)std::stoll(number, nullptr, 0) : std::stof(number), isInteger);
+		} catch (const std::logic_error&) {
+			throw std::runtime_error("Number " + token + " Isn't Supported");
+		}
+	}
+
+	SDFValue ParsePrimary() {
+		int mark = nextRegister;
+		std::string token = Next();
+		if (token == "(") {
+			SDFValue value = ParseExpression();
+			Expect(")");
+			return value;
+		}
+		if (IsNumber(token)) {
+			return ParseNumber(token);
+		}
+		if ((token == "true") || (token == "false")) {
+			return Constant((token == "true") ? 1.0f : 0.0f, true);
+		}
+		if (!IsIdentifier(token)) {
+			throw std::runtime_error("Unexpected " + token);
+		}
+		if (!Accept("(")) {
+			if (FindVariable(token) != nullptr) {
+				SDFValue variable = Variable(token);
+				if ((Peek() == "++") || (Peek() == "--")) {
+					// Postfix Increment Keeps A Copy Of The Old Value
+					std::string op = Next();
+					Emit(SDF_OP_MOVE, Allocate(), variable.size, variable.index);
+					SDFValue one = Constant(1.0f, true);
+					Emit((op == "++") ? SDF_OP_ADD : SDF_OP_SUBTRACT, variable.index, variable.size, variable.index, one.index);
+					return Result(mark, variable.size, variable.isInteger);
+				}
+				return variable;
+			}
+			auto it = defines.find(token);
+			if ((it != defines.end()) && !it->second.empty()) {
+				std::string value = it->second;
+				bool isNegative = (value[0] == '-');
+				if (IsNumber(value.substr(isNegative ? 1 : 0))) {
+					SDFValue number = ParseNumber(value.substr(isNegative ? 1 : 0));
+					if (isNegative) {
+						Emit(SDF_OP_NEGATE, number.index, 1, number.index);
+					}
+					return number;
+				}
+			}
+			throw std::runtime_error("Identifier " + token + " Isn't Supported");
+		}
+
+		if ((token == "float") || (token == "vec2") || (token == "vec3") || (token == "int") || (token == "uint") || (token == "bool")) {
+			return ParseConstructor(Type(token), mark);
+		}
+		if (functionBodies.count(token) > 0) {
+			return Inline(token, mark);
+		}
+		return ParseBuiltIn(token, mark);
+	}
+
+	SDFValue ParseConstructor(const SDFValue& type, int mark) {
+		std::vector<SDFValue> arguments = ParseArguments();
+		if (arguments.empty()) {
+			throw std::runtime_error("Empty Constructor Isn't Supported");
+		}
+		if (arguments.size() == 1) {
+			// Floats Already Fill Every Component, Bigger Vectors Just Lose Their Last Components
+			SDFValue value = arguments[0];
+			if (type.isInteger && !value.isInteger) {
+				Emit(SDF_OP_TRUNC, mark, 1, value.index);
+				return Result(mark, 1, true);
+			}
+			if ((type.size == 1) && (value.size > 1)) {
+				return Swizzle(value, {0}, mark);
+			}
+			if ((type.size > 1) && (value.size > 1) && (value.size < type.size)) {
+				throw std::runtime_error("Constructor Needs More Components");
+			}
+			return {value.index, type.size, type.isInteger};
+		}
+		// Components Are Inserted One By One Into A Register Above Every Argument
+		int destination = Allocate();
+		int component = 0;
+		for (const SDFValue& argument : arguments) {
+			for (int i = 0; (i < argument.size) && (component < type.size); i++) {
+				Emit(SDF_OP_INSERT, destination, type.size, argument.index, ((argument.size == 1) ? 0 : i) | (component << 2));
+				component++;
+			}
+		}
+		if (component < type.size) {
+			throw std::runtime_error("Constructor Needs More Components");
+		}
+		if (destination != mark) {
+			Emit(SDF_OP_MOVE, mark, type.size, destination);
+		}
+		return Result(mark, type.size, false);
+	}
+
+	SDFValue Inline(const std::string& name, int mark) {
+		// Arguments Of in Parameters Are Copied Unless They Are Already Temporary, out And inout Ones Are Passed As Their Variables
+		for (const InlinedFunction& function : inlined) {
+			if (function.name == name) {
+				throw std::runtime_error("Recursive Function " + name + " Isn't Supported");
+			}
+		}
+		const std::vector<std::string>& parameters = functionParameters[name];
+		const std::vector<std::string>& names = functionParameterNames[name];
+		std::map<std::string, SDFValue> bound;
+		size_t count = 0;
+		if (!Accept(")")) {
+			do {
+				if (count >= parameters.size()) {
+					throw std::runtime_error("Overloaded Function " + name + " Isn't Supported");
+				}
+				std::string qualifier = parameters[count].substr(0, parameters[count].find(' '));
+				SDFValue type = Type(parameters[count].substr(parameters[count].find(' ') + 1));
+				SDFValue value;
+				if (qualifier == "in") {
+					int argumentMark = nextRegister;
+					value = ParseAssignment();
+					if (value.index < argumentMark) {
+						int index = Allocate();
+						Emit(SDF_OP_MOVE, index, type.size, value.index);
+						value.index = index;
+					}
+				} else {
+					value = Variable(Next());
+					if ((Peek() != ",") && (Peek() != ")")) {
+						throw std::runtime_error("Argument Of " + name + " Must Be A Variable");
+					}
+				}
+				bound[names[count]] = {value.index, type.size, type.isInteger};
+				count++;
+			} while (Accept(","));
+			Expect(")");
+		}
+		if (count != parameters.size()) {
+			throw std::runtime_error("Overloaded Function " + name + " Isn't Supported");
+		}
+		if (nextRegister == mark) {
+			Allocate();
+		}
+
+		std::vector<std::map<std::string, SDFValue>> callerScopes = scopes;
+		scopes.resize(1);
+		scopes.push_back(bound);
+		inlined.push_back({name, mark, {}});
+		std::vector<Loop> callerLoops;
+		std::swap(loops, callerLoops);
+		size_t callerPosition = position;
+		position = functionBodies[name];
+		CompileStatement();
+		position = callerPosition;
+		std::swap(loops, callerLoops);
+		for (int instruction : inlined.back().returns) {
+			Patch(instruction, (int)program.size());
+		}
+		inlined.pop_back();
+		scopes = callerScopes;
+
+		std::string returnType = functionReturnTypes[name];
+		SDFValue type = (returnType == "void") ? SDFValue{0, 1, false} : Type(returnType);
+		return Result(mark, type.size, type.isInteger);
+	}
+
+	SDFValue ParseBuiltIn(const std::string& name, int mark) {
+		// Built-In Functions With Their Opcodes, Functions Of Floats Work Component-Wise On Vectors
+		const std::map<std::string, int> unary = {
+			{"sin", SDF_OP_SIN}, {"cos", SDF_OP_COS}, {"tan", SDF_OP_TAN}, {"asin", SDF_OP_ASIN}, {"acos", SDF_OP_ACOS}, {"atan", SDF_OP_ATAN},
+			{"exp", SDF_OP_EXP}, {"exp2", SDF_OP_EXP2}, {"log", SDF_OP_LOG}, {"log2", SDF_OP_LOG2}, {"sqrt", SDF_OP_SQRT},
+			{"inversesqrt", SDF_OP_INVERSESQRT}, {"abs", SDF_OP_ABS}, {"sign", SDF_OP_SIGN}, {"floor", SDF_OP_FLOOR},
+			{"ceil", SDF_OP_CEIL}, {"fract", SDF_OP_FRACT}, {"trunc", SDF_OP_TRUNC}, {"normalize", SDF_OP_NORMALIZE}, {"length", SDF_OP_LENGTH}
+		};
+		const std::map<std::string, int> binary = {
+			{"atan", SDF_OP_ATAN2}, {"pow", SDF_OP_POW}, {"mod", SDF_OP_MOD}, {"min", SDF_OP_MIN}, {"max", SDF_OP_MAX},
+			{"step", SDF_OP_STEP}, {"dot", SDF_OP_DOT}, {"distance", SDF_OP_DISTANCE}, {"cross", SDF_OP_CROSS}, {"smin", SDF_OP_SMIN}
+		};
+		const std::map<std::string, int> ternary = {
+			{"clamp", SDF_OP_CLAMP}, {"mix", SDF_OP_MIX}, {"fma", SDF_OP_FMA}, {"smoothstep", SDF_OP_SMOOTHSTEP}
+		};
+		std::vector<SDFValue> arguments = ParseArguments();
+		int size = 1;
+		for (const SDFValue& argument : arguments) {
+			size = std::max(size, argument.size);
+		}
+
+		const std::map<std::string, int>* opcodes = nullptr;
+		if (arguments.size() == 1) {
+			opcodes = &unary;
+		} else if (arguments.size() == 2) {
+			opcodes = &binary;
+		} else if (arguments.size() == 3) {
+			opcodes = &ternary;
+		}
+		if ((opcodes != nullptr) && (opcodes->count(name) > 0)) {
+			int op = opcodes->at(name);
+			// Normalized Float Is Its Sign, Functions Giving Floats Only See The Components Of Their Vectors
+			if ((op == SDF_OP_NORMALIZE) && (size == 1)) {
+				op = SDF_OP_SIGN;
+			}
+			// Shader Only Has smin Of float And vec2, Compiled Pipelines Couldn't Have It Either
+			if ((op == SDF_OP_SMIN) && (size == 3)) {
+				throw std::runtime_error("Function smin Of vec3 Isn't Supported");
+			}
+			Emit(op, mark, size, arguments[0].index, (arguments.size() > 1) ? arguments[1].index : 0, (arguments.size() > 2) ? arguments[2].index : 0);
+			bool isFloat = (op == SDF_OP_LENGTH) || (op == SDF_OP_DOT) || (op == SDF_OP_DISTANCE);
+			bool isInteger = (op == SDF_OP_ABS) || (op == SDF_OP_SIGN) || (op == SDF_OP_MIN) || (op == SDF_OP_MAX) || (op == SDF_OP_CLAMP);
+			return Result(mark, isFloat ? 1 : size, isInteger && arguments[0].isInteger);
+		}
+		if (((name == "radians") || (name == "degrees")) && (arguments.size() == 1)) {
+			SDFValue factor = Constant((name == "radians") ? glm::radians(1.0f) : glm::degrees(1.0f), false);
+			Emit(SDF_OP_MULTIPLY, mark, size, arguments[0].index, factor.index);
+			return Result(mark, size, false);
+		}
+		if ((name == "minMaterial") && (arguments.size() == 4)) {
+			int condition = Allocate();
+			Emit(SDF_OP_LESS, condition, 1, arguments[0].index, arguments[1].index);
+			Emit(SDF_OP_SELECT, mark, 1, condition, arguments[2].index, arguments[3].index);
+			return Result(mark, 1, false);
+		}
+		throw std::runtime_error("Function " + name + " Isn't Supported");
+	}
+};
+
+float InterpretSDFBytecode(const std::vector<glm::ivec4>& code, int start, const glm::vec3& p) {
+	// Same As InterpretSDF In Shader, Lets SDFs Be Evaluated On CPU
+	std::array<glm::vec3, SDF_REGISTERS_COUNT> registers{};
+	registers[0] = p;
+	int pc = start;
+	for (int i = 0; (i < SDF_MAX_INSTRUCTIONS) && (pc < code.size()); i++) {
+		glm::ivec4 instruction = code[pc];
+		int op = instruction.x & 255;
+		int destination = (instruction.x >> 8) & 255;
+		int size = instruction.x >> 16;
+		pc++;
+		if (op == SDF_OP_RETURN) {
+			return registers[instruction.y].x;
+		} else if (op == SDF_OP_JUMP) {
+			pc = start + instruction.y;
+		} else if (op == SDF_OP_JUMP_ZERO) {
+			if (registers[instruction.y].x == 0.0f) {
+				pc = start + instruction.z;
+			}
+		} else if (op == SDF_OP_CONSTANT) {
+			registers[destination] = glm::intBitsToFloat(glm::ivec3(instruction.y, instruction.z, instruction.w));
+		} else if (op == SDF_OP_SWIZZLE) {
+			glm::vec4 a = glm::vec4(registers[instruction.y], 0.0f);
+			registers[destination] = glm::vec3(a[instruction.z & 3], a[(instruction.z >> 2) & 3], a[(instruction.z >> 4) & 3]);
+		} else if (op == SDF_OP_INSERT) {
+			registers[destination][(instruction.z >> 2) & 3] = registers[instruction.y][instruction.z & 3];
+		} else {
+			glm::vec3 a = registers[instruction.y];
+			glm::vec3 b = registers[instruction.z];
+			glm::vec3 c = registers[instruction.w];
+			glm::vec3 mask = glm::vec3(1.0f, (size > 1) ? 1.0f : 0.0f, (size > 2) ? 1.0f : 0.0f);
+			glm::vec3 d = a;
+			switch (op) {
+			case SDF_OP_NEGATE: d = -a; break;
+			case SDF_OP_NOT: d = 1.0f - a; break;
+			case SDF_OP_ADD: d = a + b; break;
+			case SDF_OP_SUBTRACT: d = a - b; break;
+			case SDF_OP_MULTIPLY: d = a * b; break;
+			case SDF_OP_DIVIDE: d = a / b; break;
+			case SDF_OP_LESS: d = glm::vec3(glm::lessThan(a, b)); break;
+			case SDF_OP_LESS_EQUAL: d = glm::vec3(glm::lessThanEqual(a, b)); break;
+			case SDF_OP_GREATER: d = glm::vec3(glm::greaterThan(a, b)); break;
+			case SDF_OP_GREATER_EQUAL: d = glm::vec3(glm::greaterThanEqual(a, b)); break;
+			case SDF_OP_EQUAL: d = glm::vec3(glm::equal(a, b)); break;
+			case SDF_OP_NOT_EQUAL: d = glm::vec3(glm::notEqual(a, b)); break;
+			case SDF_OP_AND: d = a * b; break;
+			case SDF_OP_OR: d = glm::max(a, b); break;
+			case SDF_OP_SELECT: d = (a.x != 0.0f) ? b : c; break;
+			case SDF_OP_SIN: d = glm::sin(a); break;
+			case SDF_OP_COS: d = glm::cos(a); break;
+			case SDF_OP_TAN: d = glm::tan(a); break;
+			case SDF_OP_ASIN: d = glm::asin(a); break;
+			case SDF_OP_ACOS: d = glm::acos(a); break;
+			case SDF_OP_ATAN: d = glm::atan(a); break;
+			case SDF_OP_ATAN2: d = glm::atan(a, b); break;
+			case SDF_OP_EXP: d = glm::exp(a); break;
+			case SDF_OP_EXP2: d = glm::exp2(a); break;
+			case SDF_OP_LOG: d = glm::log(a); break;
+			case SDF_OP_LOG2: d = glm::log2(a); break;
+			case SDF_OP_SQRT: d = glm::sqrt(a); break;
+			case SDF_OP_INVERSESQRT: d = glm::inversesqrt(a); break;
+			case SDF_OP_POW: d = glm::pow(a, b); break;
+			case SDF_OP_ABS: d = glm::abs(a); break;
+			case SDF_OP_SIGN: d = glm::sign(a); break;
+			case SDF_OP_FLOOR: d = glm::floor(a); break;
+			case SDF_OP_CEIL: d = glm::ceil(a); break;
+			case SDF_OP_FRACT: d = glm::fract(a); break;
+			case SDF_OP_TRUNC: d = glm::trunc(a); break;
+			case SDF_OP_MOD: d = glm::mod(a, b); break;
+			case SDF_OP_MIN: d = glm::min(a, b); break;
+			case SDF_OP_MAX: d = glm::max(a, b); break;
+			case SDF_OP_CLAMP: d = glm::clamp(a, b, c); break;
+			case SDF_OP_MIX: d = glm::mix(a, b, c); break;
+			case SDF_OP_FMA: d = a * b + c; break;
+			case SDF_OP_STEP: d = glm::step(a, b); break;
+			case SDF_OP_SMOOTHSTEP: d = glm::smoothstep(a, b, c); break;
+			case SDF_OP_DOT: d = glm::vec3(glm::dot(a * mask, b * mask)); break;
+			case SDF_OP_LENGTH: d = glm::vec3(glm::length(a * mask)); break;
+			case SDF_OP_DISTANCE: d = glm::vec3(glm::length((a - b) * mask)); break;
+			case SDF_OP_NORMALIZE: d = glm::normalize(a * mask); break;
+			case SDF_OP_CROSS: d = glm::cross(a, b); break;
+			case SDF_OP_SMIN: {
+				// Same As smin In Shader
+				float k = SMIN_WIDTH;
+				float h = glm::max(k - glm::abs(a.x - b.x), 0.0f) / k;
+				float m = h * h * h * 0.5f;
+				float s = m * k / 3.0f;
+				if (size == 1) {
+					d = glm::vec3(glm::min(a.x, b.x) - s);
+				} else {
+					d = (a.x < b.x) ? glm::vec3(a.x - s, a.y + (b.y - a.y) * m, 0.0f) : glm::vec3(b.x - s, a.y + (b.y - a.y) * (1.0f - m), 0.0f);
+				}
+				break;
+			}
+			}
+			registers[destination] = d;
+		}
+	}
+	throw std::runtime_error("Failed To Interpret SDF Bytecode!");
+}
+
+float EstimateSDFLipschitz(const std::vector<glm::ivec4>& code, int start, const glm::vec3& size) {
+	// Largest Gradient Length Found By Central Differences At Random Points Of The Bounding Box, Which Is Centered At The Origin Of SDF Coordinates
+	// True Distance Fields Give About 1, Heightfields And Distance Estimators Often Give More
+	std::mt19937 generator(0);
+	std::uniform_real_distribution<float> uniform(-0.5f, 0.5f);
+	float h = 1e-3f * glm::length(size);
+	float lipschitz = 0.0f;
+	for (int i = 0; i < SDF_LIPSCHITZ_SAMPLES; i++) {
+		glm::vec3 p;
+		for (int j = 0; j < 3; j++) {
+			p[j] = size[j] * uniform(generator);
+		}
+		glm::vec3 gradient;
+		for (int j = 0; j < 3; j++) {
+			glm::vec3 offset(0.0f);
+			offset[j] = h;
+			gradient[j] = InterpretSDFBytecode(code, start, p + offset) - InterpretSDFBytecode(code, start, p - offset);
+		}
+		float slope = glm::length(gradient) / (2.0f * h);
+		if (std::isfinite(slope)) {
+			lipschitz = std::max(lipschitz, slope);
+		}
+	}
+	return lipschitz;
+}
+
+void GrowSDFBounds(const std::vector<glm::ivec4>& code, int start, const sdfMetadata& metadata, const glm::vec3& center, const glm::vec3& halfSize, int depth, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+	// Cells Inside The Bounds Can't Grow Them, Others Are Empty If Their Center Is Farther From Any Hit Than Their Corners
+	if (glm::all(glm::greaterThanEqual(center - halfSize, boundsMin)) && glm::all(glm::lessThanEqual(center + halfSize, boundsMax))) {
+		return;
+	}
+	if (std::abs(InterpretSDFBytecode(code, start, center)) > metadata.lipschitz * (glm::length(halfSize) + metadata.hitDistance)) {
+		return;
+	}
+	if (depth == 0) {
+		boundsMin = glm::min(boundsMin, center - halfSize);
+		boundsMax = glm::max(boundsMax, center + halfSize);
+		return;
+	}
+	for (int i = 0; i < 8; i++) {
+		glm::vec3 octant = glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) - 0.5f;
+		GrowSDFBounds(code, start, metadata, center + octant * halfSize, 0.5f * halfSize, depth - 1, boundsMin, boundsMax);
+	}
+}
+
+glm::vec3 TightSDFHalfSize(const std::vector<glm::ivec4>& code, int start, const sdfMetadata& metadata, const glm::vec3& halfSize) {
+	// Box Stays Centered At Its Position Since That Is Also The Origin Of SDF Coordinates, Boxes Without Surface Are Kept
+	glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+	glm::vec3 boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+	GrowSDFBounds(code, start, metadata, glm::vec3(0.0f), halfSize, SDF_BOUNDS_DEPTH, boundsMin, boundsMax);
+	if (boundsMin.x > boundsMax.x) {
+		return halfSize;
+	}
+	return glm::min(halfSize, glm::max(-boundsMin, boundsMax));
+}
+
+sdfMetadata ParseSDFMetadata(const std::string& glsl) {
+	// SDFs Declare How They Are Marched In Comments Like "// @lipschitz 5.2", Negative Lipschitz Bound Means It Wasn't Declared
+	// "// @distanceEstimator 1" Marks SDFs Whose Distance Is Only Estimated, Their Bound Doesn't Hold Far From The Surface
+	sdfMetadata metadata = { -1.0f, 1.70f, 0.20f, 1e-4f, false };
+	std::istringstream lines(glsl);
+	std::string line;
+	while (std::getline(lines, line)) {
+		size_t found = line.find("// @");
+		if (found == std::string::npos) {
+			continue;
+		}
+		std::istringstream directive(line.substr(found + 4));
+		std::string key;
+		float value = 0.0f;
+		if (!(directive >> key >> value) || !(value > 0.0f)) {
+			std::cout << "Invalid SDF Directive: " << line << std::endl;
+		} else if (key == "lipschitz") {
+			metadata.lipschitz = value;
+		} else if (key == "omegaMax") {
+			metadata.omegaMax = value;
+		} else if (key == "omegaSpeed") {
+			metadata.omegaSpeed = value;
+		} else if (key == "hitDistance") {
+			metadata.hitDistance = value;
+		} else if (key == "distanceEstimator") {
+			metadata.isDistanceEstimator = true;
+		} else {
+			std::cout << "Unknown SDF Directive: " << line << std::endl;
+		}
+	}
+	// Over-Relaxation Needs 1 <= Omega < 2 And Omega Moves Toward Its Target By A Fraction Each Step
+	metadata.omegaMax = glm::clamp(metadata.omegaMax, 1.0f, 1.95f);
+	metadata.omegaSpeed = glm::clamp(metadata.omegaSpeed, 0.0f, 1.0f);
+	return metadata;
+}
+
+float BakeSDFHeight(const std::vector<glm::ivec4>& code, int start, glm::vec3 p) {
+	// Surface Above A Point Is Found By Secant Steps Along y, Which Are Exact For SDFs Of The Form k * (p.y - h(p.xz))
+	float distance = InterpretSDFBytecode(code, start, p);
+	float slope = 1.0f;
+	for (int i = 0; (i < HEIGHTFIELD_BAKE_ITERATIONS) && (std::abs(distance) > 1e-6f); i++) {
+		float step = distance / slope;
+		p.y -= step;
+		float nextDistance = InterpretSDFBytecode(code, start, p);
+		if (std::abs(nextDistance - distance) > 1e-12f) {
+			slope = (distance - nextDistance) / step;
+		}
+		distance = nextDistance;
+	}
+	return std::isfinite(p.y) ? p.y : 0.0f;
+}
+
+void BakeSDFHeightfield(const std::vector<glm::ivec4>& code, int start, const glm::vec3& size, int resolution, std::vector<float>& heights) {
+	// Rows Are Split Among Threads Since Interpreting Takes Seconds For Large Grids
+	heights.resize((resolution + 1) * (resolution + 1));
+	int numThreads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<std::future<void>> rows;
+	for (int thread = 0; thread < numThreads; thread++) {
+		rows.push_back(std::async(std::launch::async, [&, thread]() {
+			for (int z = thread; z <= resolution; z += numThreads) {
+				for (int x = 0; x <= resolution; x++) {
+					heights[x + (resolution + 1) * z] = BakeSDFHeight(code, start, glm::vec3(((float)x / resolution - 0.5f) * size.x, 0.0f, ((float)z / resolution - 0.5f) * size.z));
+				}
+			}
+		}));
+	}
+	for (std::future<void>& row : rows) {
+		row.get();
+	}
+}
+
+void ResampleRawHeightfield(const std::string& raw, float heightScale, int resolution, std::vector<float>& heights) {
+	// Raw Files Are Square Grids Of 32-Bit Floats, Rows Along x, Which Are Resampled Bilinearly To The Vertices
+	size_t count = raw.size() / sizeof(float);
+	int side = (int)std::round(std::sqrt((double)count));
+	if ((side < 2) || ((size_t)side * side != count)) {
+		throw std::runtime_error("Failed To Read Heightfield, Raw Grid Isn't Square!");
+	}
+	std::vector<float> grid(count);
+	memcpy(grid.data(), raw.data(), count * sizeof(float));
+	heights.resize((resolution + 1) * (resolution + 1));
+	for (int z = 0; z <= resolution; z++) {
+		for (int x = 0; x <= resolution; x++) {
+			glm::vec2 g = glm::vec2(x, z) * ((float)(side - 1) / resolution);
+			glm::ivec2 g0 = glm::min(glm::ivec2(g), glm::ivec2(side - 2));
+			glm::vec2 f = g - glm::vec2(g0);
+			float h0 = glm::mix(grid[g0.x + side * g0.y], grid[g0.x + 1 + side * g0.y], f.x);
+			float h1 = glm::mix(grid[g0.x + side * (g0.y + 1)], grid[g0.x + 1 + side * (g0.y + 1)], f.x);
+			heights[x + (resolution + 1) * z] = heightScale * glm::mix(h0, h1, f.y);
+		}
+	}
+}
+
+void BuildHeightfieldMips(const std::vector<float>& heights, int resolution, std::vector<float>& mips) {
+	// Min-Max Pairs Of Every Cell, Then Of Every 2x2 Cells Of The Level Below Up To A Single Cell Over The Whole Grid
+	mips.clear();
+	for (int z = 0; z < resolution; z++) {
+		for (int x = 0; x < resolution; x++) {
+			float h00 = heights[x + (resolution + 1) * z];
+			float h10 = heights[x + 1 + (resolution + 1) * z];
+			float h01 = heights[x + (resolution + 1) * (z + 1)];
+			float h11 = heights[x + 1 + (resolution + 1) * (z + 1)];
+			mips.push_back(std::min(std::min(h00, h10), std::min(h01, h11)));
+			mips.push_back(std::max(std::max(h00, h10), std::max(h01, h11)));
+		}
+	}
+	size_t levelStart = 0;
+	for (int cells = resolution / 2; cells > 0; cells /= 2) {
+		int below = 2 * cells;
+		for (int z = 0; z < cells; z++) {
+			for (int x = 0; x < cells; x++) {
+				float low = std::numeric_limits<float>::max();
+				float high = -std::numeric_limits<float>::max();
+				for (int i = 0; i < 4; i++) {
+					size_t index = levelStart + 2 * ((2 * x + (i & 1)) + below * (2 * z + (i >> 1)));
+					low = std::min(low, mips[index]);
+					high = std::max(high, mips[index + 1]);
+				}
+				mips.push_back(low);
+				mips.push_back(high);
+			}
+		}
+		levelStart += 2 * below * below;
+	}
+}
+
+std::vector<float> GenerateBlueNoise() {
+	// Void And Cluster Method Of Ulichney, Energy Of A Pixel Is The Sum Of Toroidal Gaussians Of Every Set Pixel
+	// Pixels Are Ranked By Removing Tightest Clusters Out Of An Initial Pattern Then Filling Largest Voids
+	const int count = BLUE_NOISE_SIZE * BLUE_NOISE_SIZE;
+	std::vector<float> kernel(count);
+	for (int y = 0; y < BLUE_NOISE_SIZE; y++) {
+		for (int x = 0; x < BLUE_NOISE_SIZE; x++) {
+			float dx = (float)std::min(x, BLUE_NOISE_SIZE - x);
+			float dy = (float)std::min(y, BLUE_NOISE_SIZE - y);
+			kernel[x + BLUE_NOISE_SIZE * y] = std::exp(-(dx * dx + dy * dy) / (2.0f * BLUE_NOISE_SIGMA * BLUE_NOISE_SIGMA));
+		}
+	}
+
+	std::vector<uint8_t> pattern(count, 0);
+	std::vector<float> energy(count, 0.0f);
+	auto Toggle = [&](std::vector<uint8_t>& bits, std::vector<float>& energies, int index) {
+		bits[index] ^= 1;
+		float sign = (bits[index] != 0) ? 1.0f : -1.0f;
+		int px = index % BLUE_NOISE_SIZE;
+		int py = index / BLUE_NOISE_SIZE;
+		for (int y = 0; y < BLUE_NOISE_SIZE; y++) {
+			int ky = ((y - py + BLUE_NOISE_SIZE) % BLUE_NOISE_SIZE) * BLUE_NOISE_SIZE;
+			for (int x = 0; x < BLUE_NOISE_SIZE; x++) {
+				energies[x + BLUE_NOISE_SIZE * y] += sign * kernel[((x - px + BLUE_NOISE_SIZE) % BLUE_NOISE_SIZE) + ky];
+			}
+		}
+	};
+	// Tightest Cluster Is The Set Pixel Of Highest Energy, Largest Void Is The Unset Pixel Of Lowest Energy
+	auto Find = [&](const std::vector<uint8_t>& bits, const std::vector<float>& energies, uint8_t bit) {
+		int best = -1;
+		for (int i = 0; i < count; i++) {
+			if ((bits[i] == bit) && ((best < 0) || ((bit != 0) ? (energies[i] > energies[best]) : (energies[i] < energies[best])))) {
+				best = i;
+			}
+		}
+		return best;
+	};
+
+	// Initial Pattern Is A Tenth Of Random Pixels, Relaxed Until Removed Cluster Is The Void It Goes To
+	std::mt19937 generator(0);
+	std::uniform_int_distribution<int> uniform(0, count - 1);
+	int numOnes = count / 10;
+	for (int i = 0; i < numOnes; i++) {
+		int index = uniform(generator);
+		while (pattern[index] != 0) {
+			index = uniform(generator);
+		}
+		Toggle(pattern, energy, index);
+	}
+	while (true) {
+		int cluster = Find(pattern, energy, 1);
+		Toggle(pattern, energy, cluster);
+		int hole = Find(pattern, energy, 0);
+		Toggle(pattern, energy, hole);
+		if (hole == cluster) {
+			break;
+		}
+	}
+
+	std::vector<int> ranks(count, 0);
+	std::vector<uint8_t> bits = pattern;
+	std::vector<float> energies = energy;
+	for (int rank = numOnes - 1; rank >= 0; rank--) {
+		int cluster = Find(bits, energies, 1);
+		Toggle(bits, energies, cluster);
+		ranks[cluster] = rank;
+	}
+	// Lowest Energy Of Set Pixels Is Highest Energy Of Unset Ones, So Voids Are Filled Up To The Last Pixel
+	for (int rank = numOnes; rank < count; rank++) {
+		int hole = Find(pattern, energy, 0);
+		Toggle(pattern, energy, hole);
+		ranks[hole] = rank;
+	}
+
+	std::vector<float> blueNoise(count);
+	for (int i = 0; i < count; i++) {
+		blueNoise[i] = ((float)ranks[i] + 0.5f) / (float)count;
+	}
+	return blueNoise;
+}
+
+// Scene As Laid Out In The Storage Buffers Of Shader, CPU Renderer Reads It Instead Of The Device
+struct CPUScene {
+	UniformBufferObject ubo{};
+	std::vector<gpuSphere> spheres;
+	std::vector<gpuPlane> planes;
+	std::vector<gpuBox> boxes;
+	std::vector<gpuLens> lenses;
+	std::vector<gpuCyclide> cyclides;
+	std::vector<gpuPolynomial> polynomials;
+	std::vector<gpuRect> rects;
+	std::vector<gpuSDF> sdfs;
+	std::vector<gpuHeightfield> heightfields;
+	std::vector<gpuMaterial> materials;
+	std::vector<gpuLight> lights;
+	std::vector<int> lightIDs;
+	std::vector<bvhNode> bvhNodes;
+	std::vector<glm::ivec2> bvhPrimitives;
+	std::vector<glm::ivec4> sdfCode;
+	std::vector<float> heightfieldData;
+	std::vector<gpuLightNode> lightNodes;
+	std::vector<float> blueNoise;
+};
+
+// Tiles Of Pixels Left To A Thread Of CPU Renderer, Owner Takes Them From The Front And Other Threads Steal From The Back
+struct TileQueue {
+	std::mutex mutex;
+	std::deque<int> tiles;
+};
+
+// Ray Packets Of CPU Renderer, Lanes Are GCC Vector Extensions So The Same Kernels Build For Every Width
+// Kernels Are Always Inlined Into Entry Points Built For AVX2 Or AVX-512, Where Lanes Fill ymm Or zmm Registers
+// Other Compilers Only Get The Scalar Port
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_PACKETS
+#define PACKET_INLINE inline __attribute__((always_inline))
+#define PACKET_AVX2 __attribute__((target("avx2,fma")))
+#define PACKET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+// MinGW Doesn't Align Stack Beyond 16 Bytes (GCC Bug 54412), So There Lanes Only Keep Alignment Of Floats And Are Moved Unaligned
+#ifdef _WIN32
+#define PACKET_ALIGNMENT(N) 4
+#else
+#define PACKET_ALIGNMENT(N) (4 * N)
+#endif
+#endif
+
+int CPUPacketWidth() {
+	// Widest Packets The CPU Can Run, 1 Is The Scalar Port
+#ifdef CPU_PACKETS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return 16;
+	}
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		return 8;
+	}
+#endif
+	return 1;
+}
+
+#ifdef CPU_PACKETS
+// Lanes Are Aligned To Their Size Where The Stack Allows It, Which Default Target Doesn't Do For Vectors Wider Than 16 Bytes
+template<int N>
+struct PacketFloat {
+	typedef float Lanes __attribute__((vector_size(4 * N), aligned(PACKET_ALIGNMENT(N))));
+	Lanes v;
+};
+
+// Lanes Of Comparisons Are -1 If True And 0 If False
+template<int N>
+struct PacketMask {
+	typedef int32_t Lanes __attribute__((vector_size(4 * N), aligned(PACKET_ALIGNMENT(N))));
+	Lanes v;
+};
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Splat(float a) {
+	return PacketFloat<N>{a - typename PacketFloat<N>::Lanes{}};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator+(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a.v + b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator-(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a.v - b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator*(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a.v * b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator/(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a.v / b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator+(const PacketFloat<N>& a, float b) {
+	return PacketFloat<N>{a.v + b};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator-(const PacketFloat<N>& a, float b) {
+	return PacketFloat<N>{a.v - b};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator*(const PacketFloat<N>& a, float b) {
+	return PacketFloat<N>{a.v * b};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator/(const PacketFloat<N>& a, float b) {
+	return PacketFloat<N>{a.v / b};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator+(float a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a + b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator-(float a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a - b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator*(float a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a * b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator/(float a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{a / b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> operator-(const PacketFloat<N>& a) {
+	return PacketFloat<N>{-a.v};
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> MaskOf(const typename PacketMask<N>::Lanes& isTrue) {
+	// Empty asm Keeps Comparisons As Lanes Of -1 And 0, Otherwise Compiler Folds Masks Back Into Comparisons And Splits Them Lane By Lane For AVX-512
+	PacketMask<N> mask = PacketMask<N>{isTrue};
+	__asm__("" : "+v"(mask.v));
+	return mask;
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator<(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return MaskOf<N>(a.v < b.v);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator<=(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return MaskOf<N>(a.v <= b.v);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator>(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return MaskOf<N>(a.v > b.v);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator>=(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return MaskOf<N>(a.v >= b.v);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator<(const PacketFloat<N>& a, float b) {
+	return MaskOf<N>(a.v < b);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator<=(const PacketFloat<N>& a, float b) {
+	return MaskOf<N>(a.v <= b);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator>(const PacketFloat<N>& a, float b) {
+	return MaskOf<N>(a.v > b);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator>=(const PacketFloat<N>& a, float b) {
+	return MaskOf<N>(a.v >= b);
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator&(const PacketMask<N>& a, const PacketMask<N>& b) {
+	return PacketMask<N>{a.v & b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator|(const PacketMask<N>& a, const PacketMask<N>& b) {
+	return PacketMask<N>{a.v | b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketMask<N> operator!(const PacketMask<N>& a) {
+	return PacketMask<N>{~a.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Select(const PacketMask<N>& mask, const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	// Lanes Are Blended With Bit Operations, Which Compiler Can't Fold Into Nested Comparisons
+	typedef typename PacketMask<N>::Lanes Bits;
+	return PacketFloat<N>{(typename PacketFloat<N>::Lanes)(((Bits)a.v & mask.v) | ((Bits)b.v & ~mask.v))};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Min(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	// Same As glm::min, b Is Kept If a Is NaN
+	return PacketFloat<N>{(a.v < b.v) ? a.v : b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Max(const PacketFloat<N>& a, const PacketFloat<N>& b) {
+	return PacketFloat<N>{(a.v > b.v) ? a.v : b.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Abs(const PacketFloat<N>& a) {
+	return PacketFloat<N>{(a.v < 0.0f) ? -a.v : a.v};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Sign(const PacketFloat<N>& a) {
+	return Select(a > 0.0f, Splat<N>(1.0f), Select(a < 0.0f, Splat<N>(-1.0f), Splat<N>(0.0f)));
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Sqrt(const PacketFloat<N>& a) {
+	// Packets Only Run In AVX Entry Points, Where Operands Are ymm Or zmm Registers Of Their Width
+	PacketFloat<N> r;
+	__asm__("vsqrtps %1, %0" : "=v"(r.v) : "v"(a.v));
+	return r;
+}
+
+// Other Functions Without Vector Form In GCC Run Lane By Lane
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Cbrt(const PacketFloat<N>& a) {
+	// Same As sign(a) * pow(abs(a), 1 / 3) Of SolveCubic
+	PacketFloat<N> r;
+	for (int i = 0; i < N; i++) {
+		r.v[i] = glm::sign(a.v[i]) * std::pow(std::abs(a.v[i]), 0.3333333f);
+	}
+	return r;
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Acos(const PacketFloat<N>& a) {
+	PacketFloat<N> r;
+	for (int i = 0; i < N; i++) {
+		r.v[i] = std::acos(a.v[i]);
+	}
+	return r;
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Cos(const PacketFloat<N>& a) {
+	PacketFloat<N> r;
+	for (int i = 0; i < N; i++) {
+		r.v[i] = std::cos(a.v[i]);
+	}
+	return r;
+}
+
+template<int N>
+PACKET_INLINE bool Any(const PacketMask<N>& mask) {
+	// Halves Are Folded Together, So Wide Masks Are Reduced With Vector Ors Instead Of Lane By Lane
+	if constexpr (N > 4) {
+		PacketMask<N / 2> halves[2];
+		std::memcpy(halves, &mask, sizeof(halves));
+		return Any(halves[0] | halves[1]);
+	} else {
+		int32_t any = 0;
+		for (int i = 0; i < N; i++) {
+			any |= mask.v[i];
+		}
+		return any != 0;
+	}
+}
+
+template<int N>
+PACKET_INLINE uint32_t CountLanes(const PacketMask<N>& mask) {
+	uint32_t count = 0;
+	for (int i = 0; i < N; i++) {
+		count += (mask.v[i] != 0) ? 1u : 0u;
+	}
+	return count;
+}
+
+template<int N>
+struct PacketVec3 {
+	PacketFloat<N> x;
+	PacketFloat<N> y;
+	PacketFloat<N> z;
+};
+
+template<int N>
+PACKET_INLINE PacketVec3<N> Splat(const glm::vec3& a) {
+	return PacketVec3<N>{Splat<N>(a.x), Splat<N>(a.y), Splat<N>(a.z)};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> operator+(const PacketVec3<N>& a, const PacketVec3<N>& b) {
+	return PacketVec3<N>{a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> operator-(const PacketVec3<N>& a, const glm::vec3& b) {
+	return PacketVec3<N>{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> operator*(const PacketVec3<N>& a, const PacketVec3<N>& b) {
+	return PacketVec3<N>{a.x * b.x, a.y * b.y, a.z * b.z};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> operator*(const PacketVec3<N>& a, const PacketFloat<N>& b) {
+	return PacketVec3<N>{a.x * b, a.y * b, a.z * b};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> operator*(const PacketVec3<N>& a, const glm::vec3& b) {
+	return PacketVec3<N>{a.x * b.x, a.y * b.y, a.z * b.z};
+}
+
+template<int N>
+PACKET_INLINE PacketFloat<N> Dot(const PacketVec3<N>& a, const PacketVec3<N>& b) {
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> Normalize(const PacketVec3<N>& a) {
+	return a * (1.0f / Sqrt(Dot(a, a)));
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> Select(const PacketMask<N>& mask, const PacketVec3<N>& a, const PacketVec3<N>& b) {
+	return PacketVec3<N>{Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z)};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> MatrixTimesPacket(const glm::mat3& m, const PacketVec3<N>& a) {
+	// Same As m * a Of Shader
+	return PacketVec3<N>{a.x * m[0][0] + a.y * m[1][0] + a.z * m[2][0], a.x * m[0][1] + a.y * m[1][1] + a.z * m[2][1], a.x * m[0][2] + a.y * m[1][2] + a.z * m[2][2]};
+}
+
+template<int N>
+PACKET_INLINE PacketVec3<N> PacketTimesMatrix(const PacketVec3<N>& a, const glm::mat3& m) {
+	// Same As a * m Of Shader
+	return PacketVec3<N>{a.x * m[0][0] + a.y * m[0][1] + a.z * m[0][2], a.x * m[1][0] + a.y * m[1][1] + a.z * m[1][2], a.x * m[2][0] + a.y * m[2][1] + a.z * m[2][2]};
+}
+
+// Structure Of Arrays Of N Rays, Lanes Past The Last Ray Are Inactive
+template<int N>
+struct RayPacket {
+	PacketVec3<N> origin;
+	PacketVec3<N> dir;
+	PacketVec3<N> invdir;
+	PacketMask<N> active;
+};
+
+template<int N>
+struct HitPacket {
+	PacketFloat<N> hitdist;
+	PacketVec3<N> normal;
+	PacketFloat<N> materialID;
+	PacketFloat<N> lightID;
+};
+#endif
+
+// Megakernel Of Shader Ported To CPU, Every Function Follows The One With The Same Name In Shader
+// Pixels Are Written To Texels In The Layout Of Texel Buffer, So Display And SaveRender Read Them The Same Way
+// SDFs Are Always Interpreted From Bytecode, Cone Pre-Pass, Baked SDFs And Dual Number Normals Are Left To Device
+class CPURenderer {
+public:
+	CPURenderer(const CPUScene& scene, const PushConstantValues& pushConstant, std::atomic<uint64_t>* marchStats, int packetWidth) : scene(scene), pc(pushConstant), marchStats(marchStats), packetWidth(packetWidth) {
+		cameraPos = glm::vec3(pc.cameraPosX, pc.cameraPosY, pc.cameraPosZ);
+	}
+
+	void Render(std::vector<glm::vec4>& texels, std::vector<gpuPixelStats>& stats, int numThreads) {
+		// Every Thread Starts With A Run Of Neighbouring Tiles, Threads Out Of Tiles Steal The Last Tiles Of Others
+		// Adaptive Sampling Picks Unconverged Pixels Once Per Frame, Then Leaves Out Tiles Without Them
+		if (pc.isAdaptive) {
+			isPixelActive.resize(stats.size());
+			for (size_t i = 0; i < stats.size(); i++) {
+				isPixelActive[i] = !IsPixelConverged(stats[i], pc.adaptiveThreshold);
+			}
+		}
+		glm::ivec2 numTiles = (pc.resolution + CPU_TILE_SIZE - 1) / CPU_TILE_SIZE;
+		std::vector<int> tiles;
+		for (int i = 0; i < numTiles.x * numTiles.y; i++) {
+			if (!pc.isAdaptive || IsTileActive(i, numTiles.x)) {
+				tiles.push_back(i);
+			}
+		}
+		int count = (int)tiles.size();
+		if (count == 0) {
+			return;
+		}
+		numThreads = glm::clamp(numThreads, 1, count);
+		std::vector<TileQueue> queues(numThreads);
+		for (int i = 0; i < count; i++) {
+			queues[(int)(((int64_t)i * numThreads) / count)].tiles.push_back(tiles[i]);
+		}
+
+		// Errors Of Threads Are Rethrown Once Every Thread Is Done
+		std::vector<std::exception_ptr> errors(numThreads);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < numThreads; i++) {
+			threads.emplace_back([this, &queues, &errors, &texels, &stats, numTiles, i]() {
+				try {
+					int tile = 0;
+					while (PopTile(queues, i, tile)) {
+						RenderTile(tile, numTiles.x, texels, stats);
+					}
+				} catch (...) {
+					errors[i] = std::current_exception();
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		for (const std::exception_ptr& error : errors) {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	}
+
+	static bool IsPixelConverged(const gpuPixelStats& stats, float threshold) {
+		if (stats.frames < 2) {
+			return false;
+		}
+		glm::vec3 variance = stats.m2 / (float)(stats.frames - 1);
+		glm::vec3 error = glm::sqrt(variance / (float)stats.frames);
+		return glm::all(glm::lessThanEqual(error, threshold * stats.mean));
+	}
+
+	double KernelThroughput(int kernel, int width) {
+		// Rays Per Second On One Core Of A Kernel Over Camera Rays Of First Sample, Width 1 Is The Scalar Port
+		std::vector<Ray> rays;
+		for (int y = 0; y < pc.resolution.y; y++) {
+			for (int x = 0; x < pc.resolution.x; x++) {
+				glm::uvec2 xy = glm::uvec2(x, (uint32_t)pc.resolution.y - y);
+				glm::vec2 uv = (2.0f * glm::vec2(xy) - glm::vec2(pc.resolution)) / (float)pc.resolution.y;
+				uint32_t seed = GenerateSeed(xy, 0);
+				StartSampler(xy, 0);
+				Ray ray;
+				glm::vec4 l;
+				GenerateCameraRay(uv, seed, ray, l);
+				rays.push_back(ray);
+			}
+		}
+
+#ifdef CPU_PACKETS
+		if (width == 8) {
+			return PacketKernelThroughput<8>(kernel, rays);
+		}
+		if (width == 16) {
+			return PacketKernelThroughput<16>(kernel, rays);
+		}
+#endif
+		// Kernels Run Over Every Ray Until A Quarter Of A Second Has Passed, Sum Of Distances Keeps Them From Being Optimized Out
+		volatile float checksum = 0.0f;
+		uint64_t numRays = 0;
+		double seconds = 0.0;
+		auto start = std::chrono::steady_clock::now();
+		while (seconds < 0.25) {
+			float sum = 0.0f;
+			for (const Ray& ray : rays) {
+				sum += ScalarKernel(kernel, ray);
+			}
+			checksum = checksum + sum;
+			numRays += rays.size();
+			seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		return (double)numRays / seconds;
+	}
+
+private:
+	struct Ray {
+		glm::vec3 origin;
+		glm::vec3 dir;
+	};
+
+	struct sphereSlice {
+		glm::vec3 pos;
+		float radius;
+		float sliceSize;
+		bool is1stSlice;
+		glm::mat3 worldToLocal;
+		int materialID;
+		int lightID;
+	};
+
+	struct rayFootprint {
+		float spread;
+		int maxSteps;
+	};
+
+	struct sdfSet {
+		int count;
+		int ids[SDF_SET_SIZE];
+		bool isSpilled;
+	};
+
+	// Analytic Hit Of A Camera Ray Found By A Packet Before Its Path Is Traced
+	struct AnalyticHit {
+		float hitdist;
+		glm::vec3 normal;
+		float materialID;
+		float lightID;
+	};
+
+	const CPUScene& scene;
+	PushConstantValues pc;
+	std::atomic<uint64_t>* marchStats;
+	int packetWidth;
+	glm::vec3 cameraPos;
+	// Pixels Rendered By This Frame Of Adaptive Sampling, Same As The List Of Unconverged Pixels In Shader
+	std::vector<bool> isPixelActive;
+
+	// Sobol Sampler State Of Thread, Same As The Private Globals Of Invocation In Shader
+	inline static thread_local glm::uvec2 samplerPixel = glm::uvec2(0);
+	inline static thread_local uint32_t samplerIndex = 0;
+	inline static thread_local uint32_t samplerScramble = 0;
+	inline static thread_local int samplerDimension = 0;
+
+	bool PopTile(std::vector<TileQueue>& queues, int thread, int& tile) {
+		{
+			std::lock_guard<std::mutex> lock(queues[thread].mutex);
+			if (!queues[thread].tiles.empty()) {
+				tile = queues[thread].tiles.front();
+				queues[thread].tiles.pop_front();
+				return true;
+			}
+		}
+		// No Tiles Are Added While Rendering, So Once Every Queue Is Empty The Frame Is Done
+		for (size_t i = 1; i < queues.size(); i++) {
+			TileQueue& victim = queues[(thread + i) % queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tiles.empty()) {
+				tile = victim.tiles.back();
+				victim.tiles.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsTileActive(int tile, int numTilesX) {
+		glm::ivec2 start = glm::ivec2(tile % numTilesX, tile / numTilesX) * CPU_TILE_SIZE;
+		glm::ivec2 end = glm::min(start + CPU_TILE_SIZE, pc.resolution);
+		for (int y = start.y; y < end.y; y++) {
+			for (int x = start.x; x < end.x; x++) {
+				if (isPixelActive[x + pc.resolution.x * y]) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void RenderTile(int tile, int numTilesX, std::vector<glm::vec4>& texels, std::vector<gpuPixelStats>& stats) {
+		// Same As main Of Megakernel For Every Invocation Of The Tile, Converged Pixels Are Skipped As Pixels Left Out Of The List Of Shader
+		glm::ivec2 start = glm::ivec2(tile % numTilesX, tile / numTilesX) * CPU_TILE_SIZE;
+		glm::ivec2 end = glm::min(start + CPU_TILE_SIZE, pc.resolution);
+#ifdef CPU_PACKETS
+		if (packetWidth == 16) {
+			RenderTilePackets<16>(start, end, texels, stats);
+			return;
+		}
+		if (packetWidth == 8) {
+			RenderTilePackets<8>(start, end, texels, stats);
+			return;
+		}
+#endif
+		for (int y = start.y; y < end.y; y++) {
+			for (int x = start.x; x < end.x; x++) {
+				int coords = x + pc.resolution.x * y;
+				if (pc.isAdaptive && !isPixelActive[coords]) {
+					continue;
+				}
+				texels[coords] = glm::vec4(Rendering(glm::uvec2(x, y), glm::vec3(texels[coords]), stats[coords]), 1.0f);
+			}
+		}
+	}
+
+	template<typename T>
+	static T Fetch(const std::vector<T>& buffer, int index) {
+		// Out Of Range Reads Give Zeros Like Robust Buffer Access Of Device
+		return ((index >= 0) && (index < (int)buffer.size())) ? buffer[index] : T{};
+	}
+
+	static glm::vec3 YZX(const glm::vec3& v) {
+		return glm::vec3(v.y, v.z, v.x);
+	}
+
+	static glm::vec3 ZXY(const glm::vec3& v) {
+		return glm::vec3(v.z, v.x, v.y);
+	}
+
+	glm::vec3 WaveToXYZ(float wave) {
+		// Conversion From Wavelength To XYZ Using CIEXYZ1931 Table, Last Entry Has No Next One To Interpolate With
+		glm::vec3 XYZ = glm::vec3(0.0f);
+		if ((wave >= 360.0f) && (wave < 800.0f)) {
+			int index3 = 3 * (int)(glm::floor(wave) - 360.0f);
+			glm::vec3 t1 = glm::vec3(CIEXYZ1931[index3], CIEXYZ1931[index3 + 1], CIEXYZ1931[index3 + 2]);
+			glm::vec3 t2 = glm::vec3(CIEXYZ1931[index3 + 3], CIEXYZ1931[index3 + 4], CIEXYZ1931[index3 + 5]);
+			XYZ = glm::mix(t1, t2, wave - glm::floor(wave));
+		}
+		return XYZ;
+	}
+
+	gpuMaterial GetMaterialMix(float materialID) {
+		// Interpolates The Materials Either Side Of Material Mixture ID, Out Of Range IDs Fall Back To The Nearest Material
+		gpuMaterial material1 = Fetch(scene.materials, glm::max(glm::min((int)glm::floor(materialID), scene.ubo.numMaterials - 1), 0));
+		gpuMaterial material2 = Fetch(scene.materials, glm::max(glm::min((int)glm::ceil(materialID), scene.ubo.numMaterials - 1), 0));
+		gpuMaterial mat{};
+		mat.reflection = glm::mix(material1.reflection, material2.reflection, materialID - glm::floor(materialID));
+		return mat;
+	}
+
+	gpuLight GetLightMix(float lightID) {
+		int index = (int)lightID;
+		if ((index < 0) || (index >= scene.ubo.numLights)) {
+			gpuLight lt{};
+			lt.emission = glm::vec2(5500.0f, 0.0f);
+			return lt;
+		}
+		return scene.lights[index];
+	}
+
+	static void SortMinMax(glm::vec3& t1, glm::vec3& t2) {
+		glm::vec3 temp_t1 = t1;
+		glm::vec3 temp_t2 = t2;
+		t1 = glm::min(temp_t1, temp_t2);
+		t2 = glm::max(temp_t1, temp_t2);
+	}
+
+	static bool BoundingSphere(const Ray& ray, const glm::vec3& pos, float radius2) {
+		glm::vec3 localorigin = ray.origin - pos;
+		float b = glm::dot(ray.dir, localorigin);
+		float c = glm::dot(localorigin, localorigin) - radius2;
+		if ((b * b) < c) {
+			return false;
+		}
+		if ((b >= 0.0f) && (c >= 0.0f)) {
+			return false;
+		}
+		return true;
+	}
+
+	static glm::vec2 RayIntersectBounds(const glm::vec3& origin, const glm::vec3& invdir, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+		glm::vec3 tMin = (boundsMin - origin) * invdir;
+		glm::vec3 tMax = (boundsMax - origin) * invdir;
+		SortMinMax(tMin, tMax);
+		float t1 = glm::max(glm::max(tMin.x, tMin.y), tMin.z);
+		float t2 = glm::min(glm::min(tMax.x, tMax.y), tMax.z);
+		return glm::vec2(t1, t2);
+	}
+
+	static glm::vec2 RayIntersectNode(const glm::vec3& origin, const glm::vec3& invdir, const bvhNode& node) {
+		return RayIntersectBounds(origin, invdir, glm::vec3(node.boundsMin[0], node.boundsMin[1], node.boundsMin[2]), glm::vec3(node.boundsMax[0], node.boundsMax[1], node.boundsMax[2]));
+	}
+
+	static bool SphereIntersection(const Ray& ray, const gpuSphere& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		glm::vec3 localorigin = ray.origin - object.pos;
+		float b = 2.0f * glm::dot(ray.dir, localorigin);
+		float c = glm::dot(localorigin, localorigin) - (object.radius * object.radius);
+		float discriminant = b * b - 4.0f * c;
+		if (discriminant < 0.0f) {
+			return false;
+		}
+		float sqrtD = glm::sqrt(discriminant);
+		float t1 = (-b - sqrtD) * 0.5f;
+		float t2 = (-b + sqrtD) * 0.5f;
+		float t = (t1 > 0.0f) ? t1 : t2;
+		float isOutside = (t1 > 0.0f) ? 1.0f : -1.0f;
+		if (t < 1e-4f) {
+			return false;
+		}
+		if (t < hitdist) {
+			hitdist = t;
+			normal = glm::normalize((ray.dir * t + localorigin) * isOutside);
+			materialID = (float)object.materialID;
+			lightID = (float)object.lightID;
+			return true;
+		}
+		return false;
+	}
+
+	static bool PlaneIntersection(const Ray& ray, const gpuPlane& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		glm::vec3 localorigin = ray.origin - object.pos;
+		float t = -localorigin.y / ray.dir.y;
+		if (t < 1e-4f) {
+			return false;
+		}
+		if (t < hitdist) {
+			hitdist = t;
+			normal = glm::faceforward(glm::vec3(0.0f, 1.0f, 0.0f), ray.dir, glm::vec3(0.0f, 1.0f, 0.0f));
+			materialID = (float)object.materialID;
+			lightID = (float)object.lightID;
+			return true;
+		}
+		return false;
+	}
+
+	static bool RectIntersection(const Ray& ray, const gpuRect& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		glm::vec3 localorigin = worldToLocal * (ray.origin - object.pos);
+		glm::vec3 localdir = worldToLocal * ray.dir;
+		float t = -localorigin.y / localdir.y;
+		if (!((t >= 1e-4f) && (t < hitdist))) {
+			return false;
+		}
+		glm::vec2 p = glm::vec2(localdir.x, localdir.z) * t + glm::vec2(localorigin.x, localorigin.z);
+		if (glm::any(glm::greaterThan(glm::abs(p), 0.5f * object.size))) {
+			return false;
+		}
+		hitdist = t;
+		normal = glm::faceforward(glm::vec3(0.0f, 1.0f, 0.0f), localdir, glm::vec3(0.0f, 1.0f, 0.0f)) * worldToLocal;
+		materialID = (float)object.materialID;
+		lightID = (float)object.lightID;
+		return true;
+	}
+
+	static bool BoxIntersection(const Ray& ray, const gpuBox& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		glm::vec3 localorigin = worldToLocal * (ray.origin - object.pos);
+		glm::vec3 dir = worldToLocal * ray.dir;
+		glm::vec3 invdir = 1.0f / dir;
+		glm::vec3 tMin = (object.size * -0.5f - localorigin) * invdir;
+		glm::vec3 tMax = (object.size * 0.5f - localorigin) * invdir;
+		SortMinMax(tMin, tMax);
+		float t1 = glm::max(glm::max(tMin.x, tMin.y), tMin.z);
+		float t2 = glm::min(glm::min(tMax.x, tMax.y), tMax.z);
+		float t = (t1 < 0.0f) ? t2 : t1;
+		if ((t1 > t2) || (t < 1e-4f)) {
+			return false;
+		}
+		if (t < hitdist) {
+			hitdist = t;
+			glm::vec3 p = glm::abs((localorigin + dir * t) / object.size);
+			normal = (glm::step(glm::max(glm::max(p.x, p.y), p.z), p) * -glm::sign(dir)) * worldToLocal;
+			materialID = (float)object.materialID;
+			lightID = (float)object.lightID;
+			return true;
+		}
+		return false;
+	}
+
+	static bool SphereSliceIntersection(const Ray& ray, const sphereSlice& object, float localSlicePos, bool isSideInvert, float& hitdist, glm::vec3& normal, int& isOutside, float& materialID, float& lightID) {
+		Ray localRay;
+		float sliceOffset = object.radius - object.sliceSize;
+		localRay.origin = object.worldToLocal * (ray.origin - object.pos);
+		if (object.is1stSlice) {
+			localRay.origin.x += localSlicePos - object.sliceSize - sliceOffset;
+		} else {
+			localRay.origin.x -= localSlicePos - object.sliceSize - sliceOffset;
+		}
+		localRay.dir = object.worldToLocal * ray.dir;
+		float b = 2.0f * glm::dot(localRay.dir, localRay.origin);
+		float c = glm::dot(localRay.origin, localRay.origin) - (object.radius * object.radius);
+		float discriminant = b * b - 4.0f * c;
+		float t = 1e6f;
+		int isOut = 1;
+		if (discriminant < 0.0f) {
+			return false;
+		}
+		float sqrtD = glm::sqrt(discriminant);
+		float t1 = (-b - sqrtD) * 0.5f;
+		float t2 = (-b + sqrtD) * 0.5f;
+		if (object.is1stSlice) {
+			t1 = ((localRay.dir.x * t1 + localRay.origin.x) > -sliceOffset) ? 1e6f : t1;
+			t2 = ((localRay.dir.x * t2 + localRay.origin.x) > -sliceOffset) ? 1e6f : t2;
+		} else {
+			t1 = ((localRay.dir.x * t1 + localRay.origin.x) < sliceOffset) ? 1e6f : t1;
+			t2 = ((localRay.dir.x * t2 + localRay.origin.x) < sliceOffset) ? 1e6f : t2;
+		}
+		t = (t1 > 0.0f) ? t1 : t;
+		if (t2 < t) {
+			t = t2;
+			isOut = -1;
+		}
+		if (t < 1e-4f) {
+			return false;
+		}
+		if (t < hitdist) {
+			hitdist = t;
+			normal = glm::normalize((localRay.dir * t + localRay.origin) * (float)isOut) * object.worldToLocal;
+			isOutside = (!isSideInvert) ? isOut : -isOut;
+			materialID = (float)object.materialID;
+			lightID = (float)object.lightID;
+			return true;
+		}
+		return false;
+	}
+
+	static void SetupLens(gpuLens& object, float radius, float focalLength, float thickness, bool isConverging) {
+		float lensThicknessHalf = 2.0f * focalLength - glm::sqrt(4.0f * focalLength * focalLength - radius * radius);
+		object.sliceRadius = 2.0f * focalLength;
+		object.sliceSize = lensThicknessHalf;
+		object.slicePos = 0.5f * (isConverging ? thickness : -thickness);
+		if (isConverging) {
+			object.slicePos += lensThicknessHalf;
+		}
+		object.isConverging = isConverging ? 1 : 0;
+	}
+
+	static bool LensIntersection(const Ray& ray, const gpuLens& object, float& hitdist, glm::vec3& normal, int& isOutside, float& materialID, float& lightID) {
+		bool isIntersect = false;
+		for (int i = 0; i < 2; i++) {
+			sphereSlice slice;
+			slice.pos = object.pos;
+			slice.radius = object.sliceRadius;
+			slice.sliceSize = object.sliceSize;
+			slice.is1stSlice = (i == 0);
+			slice.worldToLocal = glm::mat3(object.worldToLocal);
+			slice.materialID = object.materialID;
+			slice.lightID = object.lightID;
+			if (SphereSliceIntersection(ray, slice, object.slicePos, object.isConverging == 0, hitdist, normal, isOutside, materialID, lightID)) {
+				isIntersect = true;
+			}
+		}
+		return isIntersect;
+	}
+
+	template<typename T>
+	static T EvalQuadratic(float a, float b, float c, T x) {
+		return x * (x * a + b) + c;
+	}
+
+	template<typename T>
+	static T EvalCubic(float a, float b, float c, float d, T x) {
+		return x * (x * (x * a + b) + c) + d;
+	}
+
+	template<typename T>
+	static T EvalQuartic(float a, float b, float c, float d, float e, T x) {
+		return x * (x * (x * (x * a + b) + c) + d) + e;
+	}
+
+	static glm::bvec3 SolveCubic(float b, float c, float d, glm::vec3& roots) {
+		const float ONEBYTHREE = 0.3333333f;
+		float bdiv3 = b * ONEBYTHREE;
+		float Q = c * ONEBYTHREE - bdiv3 * bdiv3;
+		float R = 0.5f * bdiv3 * c - bdiv3 * bdiv3 * bdiv3 - 0.5f * d;
+		float D = Q * Q * Q + R * R;
+		if (D > 0.0f) {
+			float u = R + glm::sqrt(D);
+			float v = R - glm::sqrt(D);
+			float S = glm::sign(u) * glm::pow(glm::abs(u), ONEBYTHREE);
+			float T = glm::sign(v) * glm::pow(glm::abs(v), ONEBYTHREE);
+			roots.x = S + T - bdiv3;
+			for (int i = 0; i < 2; i++) {
+				roots.x -= EvalCubic(1.0f, b, c, d, roots.x) / EvalQuadratic(3.0f, 2.0f * b, c, roots.x);
+			}
+			return glm::bvec3(true, false, false);
+		}
+		float sqrtnegQ = glm::sqrt(-Q);
+		float thetadiv3 = glm::acos(glm::clamp(R / (sqrtnegQ * sqrtnegQ * sqrtnegQ), -1.0f, 1.0f)) * ONEBYTHREE;
+		float TWOPIBYTHREE = 2.0f * PI * ONEBYTHREE;
+		roots = 2.0f * sqrtnegQ * glm::vec3(glm::cos(thetadiv3), glm::cos(thetadiv3 + TWOPIBYTHREE), glm::cos(2.0f * TWOPIBYTHREE + thetadiv3)) - bdiv3;
+		for (int i = 0; i < 2; i++) {
+			roots -= EvalCubic(1.0f, b, c, d, roots) / EvalQuadratic(3.0f, 2.0f * b, c, roots);
+		}
+		return glm::bvec3(true);
+	}
+
+	static glm::bvec4 SolveQuartic(float a, float b, float c, float d, float e, glm::vec4& roots) {
+		float inva = 1.0f / a;
+		float inva2 = inva * 0.5f;
+		float inva2a2 = inva2 * inva2;
+		float bb = b * b;
+		float p = -1.5f * bb * inva2a2 + c * inva;
+		float q = bb * b * inva2a2 * inva2 - b * c * inva * inva2 + d * inva;
+		float r = -0.1875f * bb * bb * inva2a2 * inva2a2 + 0.5f * c * bb * inva2a2 * inva2 - b * d * inva2a2 + e * inva;
+		glm::vec3 s = glm::vec3(0.0f);
+		SolveCubic(0.5f * -p, -r, 0.5f * p * r - 0.125f * q * q, s);
+		float s2subp = 2.0f * s.x - p;
+		if (s2subp < 0.0f) {
+			return glm::bvec4(false);
+		}
+		float invs2subp = -2.0f * s.x - p;
+		float sqrts2subp = glm::sqrt(s2subp);
+		float q2divsqrt = 2.0f * q / sqrts2subp;
+		float invaddq2div = invs2subp + q2divsqrt;
+		float invsubq2div = invs2subp - q2divsqrt;
+		float bdiv4a = 0.25f * inva * b;
+		glm::bvec4 isReal = glm::bvec4(false);
+		if (invaddq2div >= 0.0f) {
+			glm::vec2 xy = 0.5f * (-sqrts2subp + glm::vec2(1.0f, -1.0f) * glm::sqrt(invaddq2div)) - bdiv4a;
+			xy -= EvalQuartic(a, b, c, d, e, xy) / EvalCubic(4.0f * a, 3.0f * b, 2.0f * c, d, xy);
+			roots.x = xy.x;
+			roots.y = xy.y;
+			isReal.x = true;
+			isReal.y = true;
+		}
+		if (invsubq2div >= 0.0f) {
+			glm::vec2 zw = 0.5f * (sqrts2subp + glm::vec2(1.0f, -1.0f) * glm::sqrt(invsubq2div)) - bdiv4a;
+			zw -= EvalQuartic(a, b, c, d, e, zw) / EvalCubic(4.0f * a, 3.0f * b, 2.0f * c, d, zw);
+			roots.z = zw.x;
+			roots.w = zw.y;
+			isReal.z = true;
+			isReal.w = true;
+		}
+		return isReal;
+	}
+
+	static bool QuarticMayHaveRoot(float a, float b, float c, float d, float e, glm::vec2 interval) {
+		float t = interval.x;
+		float h = interval.y - interval.x;
+		float c0 = (((a * t + b) * t + c) * t + d) * t + e;
+		float c1 = (((4.0f * a * t + 3.0f * b) * t + 2.0f * c) * t + d) * h;
+		float c2 = ((6.0f * a * t + 3.0f * b) * t + c) * h * h;
+		float c3 = (4.0f * a * t + b) * h * h * h;
+		float c4 = a * h * h * h * h;
+		glm::vec4 bernstein = glm::vec4(0.25f * c1 + c0, c0 + 0.5f * c1 + c2 / 6.0f, c0 + 0.75f * c1 + 0.5f * c2 + 0.25f * c3, c0 + c1 + c2 + c3 + c4);
+		float bernsteinMin = glm::min(glm::min(glm::min(bernstein.x, bernstein.y), glm::min(bernstein.z, bernstein.w)), c0);
+		float bernsteinMax = glm::max(glm::max(glm::max(bernstein.x, bernstein.y), glm::max(bernstein.z, bernstein.w)), c0);
+		float T = glm::max(glm::abs(interval.x), glm::abs(interval.y));
+		float tolerance = 1e-5f * ((((glm::abs(a) * T + glm::abs(b)) * T + glm::abs(c)) * T + glm::abs(d)) * T + glm::abs(e));
+		return (bernsteinMin <= tolerance) && (bernsteinMax >= -tolerance);
+	}
+
+	static glm::bvec4 SolvePolynomial(float a4, float a3, float a2, float a1, float a0, glm::vec4& roots) {
+		float epsilon = 1e-2f * glm::max(glm::max(glm::max(glm::abs(a4), glm::abs(a3)), glm::max(glm::abs(a2), glm::abs(a1))), glm::abs(a0));
+		if (glm::abs(a4) > epsilon) {
+			return SolveQuartic(a4, a3, a2, a1, a0, roots);
+		}
+		if (glm::abs(a3) > epsilon) {
+			glm::vec3 cubicRoots = glm::vec3(0.0f);
+			glm::bvec3 isReal = SolveCubic(a2 / a3, a1 / a3, a0 / a3, cubicRoots);
+			roots = glm::vec4(cubicRoots, roots.w);
+			return glm::bvec4(isReal, false);
+		}
+		if (glm::abs(a2) > epsilon) {
+			float D = a1 * a1 - 4.0f * a2 * a0;
+			if (D < 0.0f) {
+				return glm::bvec4(false);
+			}
+			float q = -0.5f * (a1 + ((a1 < 0.0f) ? -glm::sqrt(D) : glm::sqrt(D)));
+			roots.x = q / a2;
+			roots.y = a0 / q;
+			return glm::bvec4(true, q != 0.0f, false, false);
+		}
+		if (glm::abs(a1) > epsilon) {
+			roots.x = -a0 / a1;
+			return glm::bvec4(true, false, false, false);
+		}
+		return glm::bvec4(false);
+	}
+
+	static void PolynomialMonomials(const glm::vec3& p, float monomials[POLYNOMIAL_MONOMIALS]) {
+		glm::vec3 powers[5];
+		powers[0] = glm::vec3(1.0f);
+		for (int i = 1; i < 5; i++) {
+			powers[i] = powers[i - 1] * p;
+		}
+		int n = 0;
+		for (int degree = 0; degree < 5; degree++) {
+			for (int x = degree; x >= 0; x--) {
+				for (int y = degree - x; y >= 0; y--) {
+					monomials[n] = powers[x].x * powers[y].y * powers[degree - x - y].z;
+					n++;
+				}
+			}
+		}
+	}
+
+	bool PolynomialIntersection(const Ray& ray, int index, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		const int monomialsBelow[6] = {0, 1, 4, 10, 20, 35};
+		const gpuPolynomial& object = scene.polynomials[index];
+		glm::vec3 o = ray.origin - object.pos;
+		float b = glm::dot(o, ray.dir);
+		float D = b * b - glm::dot(o, o) + object.boundingRadius2;
+		if (D < 0.0f) {
+			return false;
+		}
+		glm::vec2 tSphere = -b + glm::vec2(-1.0f, 1.0f) * glm::sqrt(D);
+		float tStart = glm::max(tSphere.x, 0.0f);
+		if ((tSphere.y < 0.0f) || (tStart > hitdist)) {
+			return false;
+		}
+		o = ray.dir * tStart + o;
+
+		float monomialsO[POLYNOMIAL_MONOMIALS];
+		float monomialsD[POLYNOMIAL_MONOMIALS];
+		PolynomialMonomials(o, monomialsO);
+		PolynomialMonomials(ray.dir, monomialsD);
+		float a[5];
+		int n = 0;
+		for (int k = 0; k < 5; k++) {
+			a[k] = 0.0f;
+			for (int i = monomialsBelow[k]; i < monomialsBelow[k + 1]; i++) {
+				float sum = 0.0f;
+				for (int j = 0; j < monomialsBelow[5 - k]; j++) {
+					sum = object.terms[n] * monomialsO[j] + sum;
+					n++;
+				}
+				a[k] = sum * monomialsD[i] + a[k];
+			}
+		}
+		float tLength = tSphere.y - tStart;
+		float power = 1.0f;
+		for (int k = 0; k < 5; k++) {
+			a[k] *= power;
+			power *= tLength;
+		}
+
+		glm::vec4 roots = glm::vec4(0.0f);
+		glm::bvec4 isReal = SolvePolynomial(a[4], a[3], a[2], a[1], a[0], roots);
+		glm::vec2 xy = glm::vec2(roots.x, roots.y);
+		glm::vec2 zw = glm::vec2(roots.z, roots.w);
+		for (int i = 0; i < 2; i++) {
+			glm::vec2 f = EvalQuartic(a[4], a[3], a[2], a[1], a[0], xy);
+			glm::vec2 df = EvalCubic(4.0f * a[4], 3.0f * a[3], 2.0f * a[2], a[1], xy);
+			xy -= glm::mix(glm::vec2(0.0f), f / df, glm::lessThan(glm::abs(f), glm::abs(df)));
+			f = EvalQuartic(a[4], a[3], a[2], a[1], a[0], zw);
+			df = EvalCubic(4.0f * a[4], 3.0f * a[3], 2.0f * a[2], a[1], zw);
+			zw -= glm::mix(glm::vec2(0.0f), f / df, glm::lessThan(glm::abs(f), glm::abs(df)));
+		}
+		roots = glm::vec4(xy, zw) * tLength;
+
+		float t = glm::min(hitdist, tSphere.y) - tStart;
+		bool isHit = false;
+		for (int i = 0; i < 4; i++) {
+			if (isReal[i] && (roots[i] < t) && (roots[i] > 0.0f)) {
+				t = roots[i];
+				isHit = true;
+			}
+		}
+
+		if (isHit) {
+			hitdist = t + tStart;
+			PolynomialMonomials(ray.dir * t + o, monomialsO);
+			n = monomialsBelow[5];
+			for (int i = 0; i < 3; i++) {
+				normal[i] = 0.0f;
+				for (int j = 0; j < monomialsBelow[4]; j++) {
+					normal[i] = object.terms[n] * monomialsO[j] + normal[i];
+					n++;
+				}
+			}
+			normal = glm::normalize(glm::faceforward(normal, ray.dir, normal));
+			materialID = (float)object.materialID;
+			lightID = -1.0f;
+			return true;
+		}
+		return false;
+	}
+
+	bool DupinCyclide(const Ray& ray, const gpuCyclide& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		glm::vec3 localOrigin = (worldToLocal * (ray.origin - object.pos)) * object.invScale;
+		glm::vec3 localDir = (worldToLocal * ray.dir) * object.invScale;
+		glm::vec3 o = glm::vec3(localOrigin.x, localOrigin.z, localOrigin.y);
+		glm::vec3 d = glm::vec3(localDir.x, localDir.z, localDir.y);
+		bool isCount = (pc.isCountMarchSteps != 0);
+		if (isCount) {
+			marchStats[3]++;
+		}
+		glm::vec2 tBox = RayIntersectBounds(o, 1.0f / d, object.boundsMin, object.boundsMax);
+		tBox = glm::vec2(glm::max(tBox.x, 0.0f), glm::min(tBox.y, hitdist));
+		if (tBox.x > tBox.y) {
+			return false;
+		}
+		float a = object.a;
+		float b = object.b;
+		float c = object.c;
+		float e = object.d;
+		float a4 = glm::dot(d * d, d * d) + 2.0f * glm::dot(d * d, YZX(d) * YZX(d));
+		float a3 = 4.0f * (glm::dot(o, d * d * d) + glm::dot(o * d, YZX(d) * YZX(d)) + glm::dot(o * d, ZXY(d) * ZXY(d)));
+		float a2 = 6.0f * glm::dot(o * o, d * d) + 8.0f * glm::dot(o * d, YZX(o) * YZX(d)) + 2.0f * (glm::dot(o * o, YZX(d) * YZX(d)) + glm::dot(o * o, ZXY(d) * ZXY(d))) + 2.0f * (b * b - e * e) * glm::dot(d, d) - 4.0f * (a * a * d.x * d.x + b * b * d.y * d.y);
+		float a1 = 4.0f * (glm::dot(o * o * o, d) + glm::dot(o * o, YZX(o) * YZX(d)) + glm::dot(o * o, ZXY(o) * ZXY(d)) + 2.0f * a * c * e * d.x + (b * b - e * e) * glm::dot(o, d) - 2.0f * (a * a * o.x * d.x + b * b * o.y * d.y));
+		float a0 = glm::dot(o * o, o * o) + 2.0f * glm::dot(o * o, YZX(o) * YZX(o)) + b * b * b * b + e * e * e * e - 2.0f * b * b * e * e - 4.0f * c * c * e * e + 8.0f * a * c * e * o.x + 2.0f * (b * b - e * e) * glm::dot(o, o) - 4.0f * (a * a * o.x * o.x + b * b * o.y * o.y);
+
+		if ((pc.isCyclideIntervalTest != 0) && !QuarticMayHaveRoot(a4, a3, a2, a1, a0, tBox)) {
+			return false;
+		}
+
+		glm::vec4 roots = glm::vec4(0.0f);
+		glm::bvec4 isReal = SolveQuartic(a4, a3, a2, a1, a0, roots);
+
+		float t = 1e6f;
+		for (int i = 0; i < 4; i++) {
+			if (isReal[i] && (roots[i] < t) && (roots[i] > 0.0f) && (roots[i] >= tBox.x) && (roots[i] <= tBox.y)) {
+				t = roots[i];
+			}
+		}
+		if (isCount) {
+			marchStats[4]++;
+			if (t >= hitdist) {
+				marchStats[5]++;
+			}
+		}
+
+		if (t < hitdist) {
+			hitdist = t;
+			float x = o.x + d.x * t;
+			float y = o.y + d.y * t;
+			float z = o.z + d.z * t;
+			float term1 = x * x + y * y + z * z + b * b - e * e;
+			normal.x = 4.0f * (x * term1 - 2.0f * a * (a * x - c * e));
+			normal.y = 4.0f * z * term1;
+			normal.z = 4.0f * y * (term1 - 2.0f * b * b);
+			normal = glm::normalize(normal);
+			materialID = (float)object.materialID;
+			lightID = (float)object.lightID;
+			return true;
+		}
+		return false;
+	}
+
+	float EvaluateSDF(int index, glm::vec3 p) {
+		// Every SDF Runs Its Bytecode, As It Does On Device Before Its Function Is Compiled
+		const gpuSDF& object = scene.sdfs[index];
+		p -= object.pos;
+		return (object.codeOffset >= 0) ? InterpretSDFBytecode(scene.sdfCode, object.codeOffset, p) : MAXDIST;
+	}
+
+	float EvaluateSDFMATERIAL(int index, glm::vec3 p) {
+		const gpuSDF& object = scene.sdfs[index];
+		p -= object.pos;
+		return (object.materialCodeOffset >= 0) ? InterpretSDFBytecode(scene.sdfCode, object.materialCodeOffset, p) : 0.0f;
+	}
+
+	float ScaledSDF(int index, const glm::vec3& p) {
+		return EvaluateSDF(index, p) * scene.sdfs[index].stepScale;
+	}
+
+	int SDFSetCount(const sdfSet& set) {
+		return set.isSpilled ? scene.ubo.numObjects[5] : set.count;
+	}
+
+	int SDFSetID(const sdfSet& set, int i) {
+		return set.isSpilled ? i : set.ids[i];
+	}
+
+	float SDF(const glm::vec3& p, const sdfSet& set) {
+		float sdf = MAXDIST;
+		for (int i = 0; i < SDFSetCount(set); i++) {
+			sdf = glm::min(sdf, EvaluateSDF(SDFSetID(set, i), p));
+		}
+		return sdf;
+	}
+
+	glm::vec3 CalculateSDFNormals(int index, const glm::vec3& p) {
+		// Tetrahedral Taps, Same As TetrahedralSDFGradient
+		float epsilon = 1e-4f;
+		glm::vec3 xyy = glm::vec3(1.0f, -1.0f, -1.0f);
+		glm::vec3 yyx = glm::vec3(-1.0f, -1.0f, 1.0f);
+		glm::vec3 yxy = glm::vec3(-1.0f, 1.0f, -1.0f);
+		glm::vec3 xxx = glm::vec3(1.0f, 1.0f, 1.0f);
+		glm::vec3 gradient = xyy * EvaluateSDF(index, p + xyy * epsilon) +
+			yyx * EvaluateSDF(index, p + yyx * epsilon) +
+			yxy * EvaluateSDF(index, p + yxy * epsilon) +
+			xxx * EvaluateSDF(index, p + xxx * epsilon);
+		return glm::normalize(gradient);
+	}
+
+	void SearchSDFBox(const glm::vec3& p, const glm::vec3& invdir, int index, bool isCollect, float& tEnter, float& tEnd, sdfSet& set) {
+		const gpuSDF& object = scene.sdfs[index];
+		glm::vec3 halfSize = 0.5f * object.size;
+		glm::vec2 boxMinMax = RayIntersectBounds(p, invdir, object.pos - halfSize, object.pos + halfSize);
+		if ((boxMinMax.x > boxMinMax.y) || (boxMinMax.y < 0.0f)) {
+			return;
+		}
+		if (!isCollect) {
+			tEnter = glm::min(tEnter, glm::max(boxMinMax.x, 0.0f));
+			return;
+		}
+		if (boxMinMax.x > tEnter) {
+			tEnd = glm::min(tEnd, boxMinMax.x);
+		} else if (boxMinMax.y >= tEnter) {
+			tEnd = glm::min(tEnd, boxMinMax.y);
+			if (set.count < SDF_SET_SIZE) {
+				set.ids[set.count] = index;
+				set.count++;
+			} else {
+				set.isSpilled = true;
+			}
+		}
+	}
+
+	void TraverseSDFBoxes(const glm::vec3& p, const glm::vec3& invdir, bool isCollect, float& tEnter, float& tEnd, sdfSet& set) {
+		if (scene.ubo.sdfBVHRoot < 0) {
+			for (int i = 0; i < scene.ubo.numObjects[5]; i++) {
+				SearchSDFBox(p, invdir, i, isCollect, tEnter, tEnd, set);
+			}
+			return;
+		}
+
+		int stack[BVH_STACK_SIZE];
+		int stackSize = 1;
+		stack[0] = scene.ubo.sdfBVHRoot;
+		while (stackSize > 0) {
+			stackSize--;
+			const bvhNode& node = scene.bvhNodes[stack[stackSize]];
+			glm::vec2 tNode = RayIntersectNode(p, invdir, node);
+			if ((tNode.x > tNode.y) || (tNode.y < 0.0f) || (tNode.x > (isCollect ? tEnd : tEnter))) {
+				continue;
+			}
+			if (node.count > 0) {
+				for (int i = 0; i < node.count; i++) {
+					SearchSDFBox(p, invdir, scene.bvhPrimitives[node.leftFirst + i].y, isCollect, tEnter, tEnd, set);
+				}
+				continue;
+			}
+			stack[stackSize] = node.leftFirst + 1;
+			stack[stackSize + 1] = node.leftFirst;
+			stackSize += 2;
+		}
+	}
+
+	bool SearchSDF(const glm::vec3& p, const glm::vec3& invdir, glm::vec2& tMinMax, sdfSet& set) {
+		set.count = 0;
+		set.isSpilled = false;
+		float tEnter = MAXDIST;
+		float tEnd = MAXDIST;
+		TraverseSDFBoxes(p, invdir, false, tEnter, tEnd, set);
+		if (tEnter >= MAXDIST) {
+			return false;
+		}
+		TraverseSDFBoxes(p, invdir, true, tEnter, tEnd, set);
+		tMinMax = glm::vec2(tEnter, tEnd);
+		return true;
+	}
+
+	float MarchSDF(const glm::vec3& p, const sdfSet& set, int& closest) {
+		// Nothing Is Baked On CPU, So Every Step Uses The Scaled SDF
+		float sdf = MAXDIST;
+		for (int i = 0; i < SDFSetCount(set); i++) {
+			int id = SDFSetID(set, i);
+			float radius = ScaledSDF(id, p);
+			if (radius < sdf) {
+				sdf = radius;
+				closest = id;
+			}
+		}
+		return sdf;
+	}
+
+	void RelaxationLimits(const sdfSet& set, float& omegaMax, float& omegaSpeed) {
+		omegaMax = 2.0f;
+		omegaSpeed = 1.0f;
+		for (int i = 0; i < SDFSetCount(set); i++) {
+			omegaMax = glm::min(omegaMax, scene.sdfs[SDFSetID(set, i)].omegaMax);
+			omegaSpeed = glm::min(omegaSpeed, scene.sdfs[SDFSetID(set, i)].omegaSpeed);
+		}
+	}
+
+	bool SphereMarchSteps(const Ray& ray, float maxDist, float sdfStart, const rayFootprint& footprint, float& t, int& sdfID, int& steps) {
+		if (sdfStart >= maxDist) {
+			return false;
+		}
+		t = glm::max(sdfStart, 1e-3f);
+		sdfSet set;
+		float insT = 0.0f;
+		float omegaMax = 1.0f;
+		float omegaSpeed = 0.0f;
+		float omega = 1.0f;
+		float omegaSpeedFactor = 0.0f;
+		float previousRadius = 0.0f;
+		glm::vec3 start = ray.dir * sdfStart + ray.origin;
+		glm::vec3 p = start;
+		glm::vec3 invdir = 1.0f / ray.dir;
+		int points = 0;
+		glm::vec2 tMinMax = glm::vec2(MAXDIST);
+		if (SearchSDF(p, invdir, tMinMax, set)) {
+			tMinMax += glm::vec2(sdfStart);
+			t = glm::max(tMinMax.x, t);
+			p = ray.dir * t + ray.origin;
+			RelaxationLimits(set, omegaMax, omegaSpeed);
+			omega = omegaMax;
+		} else {
+			return false;
+		}
+		float k = glm::sign(SDF(start, set));
+
+		for (int i = 0; i < footprint.maxSteps; i++) {
+			steps = i + 1;
+			float radius = MarchSDF(p, set, sdfID);
+			if (insT > (glm::abs(previousRadius) + glm::abs(radius))) {
+				t -= insT;
+				omega = 1.0f;
+
+				insT = previousRadius * omega * k;
+				t += insT;
+				p = ray.dir * t + ray.origin;
+				continue;
+			}
+			if (glm::abs(radius) < glm::max(scene.sdfs[sdfID].hitDistance, FOOTPRINT_HIT_SCALE * footprint.spread * t)) {
+				break;
+			}
+			if (t > maxDist) {
+				return false;
+			}
+			if (t > tMinMax.y) {
+				points += 1;
+			} else {
+				points = 0;
+			}
+			if (points >= 2) {
+				t = tMinMax.y + 1e-3f;
+				tMinMax = glm::vec2(MAXDIST);
+				if (SearchSDF(ray.dir * t + ray.origin, invdir, tMinMax, set)) {
+					tMinMax += glm::vec2(t);
+					t = glm::max(tMinMax.x, t);
+					p = ray.dir * t + ray.origin;
+					RelaxationLimits(set, omegaMax, omegaSpeed);
+					omega = glm::min(omega, omegaMax);
+					continue;
+				} else {
+					return false;
+				}
+			}
+			insT = radius * omega * k;
+			t += insT;
+			p = ray.dir * t + ray.origin;
+			omegaSpeedFactor = glm::min(radius / previousRadius, 0.99f);
+			omega += omegaSpeed * (glm::min(1.0f / (1.0f - omegaSpeedFactor), omegaMax) - omega);
+			previousRadius = radius;
+		}
+
+		return t < maxDist;
+	}
+
+	bool SphereMarch(const Ray& ray, float maxDist, float sdfStart, const rayFootprint& footprint, float& t, int& sdfID) {
+		int steps = 0;
+		bool isHit = SphereMarchSteps(ray, maxDist, sdfStart, footprint, t, sdfID, steps);
+		if ((pc.isCountMarchSteps != 0) && (steps > 0)) {
+			marchStats[0]++;
+			marchStats[1] += (uint64_t)steps;
+			if (steps >= footprint.maxSteps) {
+				marchStats[2]++;
+			}
+		}
+		return isHit;
+	}
+
+	rayFootprint RayFootprint(int bounce) {
+		if (pc.isFootprintMarching == 0) {
+			return rayFootprint{0.0f, SDF_MARCH_STEPS};
+		}
+		float pixelAngle = pc.cameraSize / ((float)pc.resolution.y * pc.lensDistance);
+		return rayFootprint{(float)bounce * FOOTPRINT_BOUNCE_SPREAD + pixelAngle, glm::max(SDF_MARCH_STEPS >> glm::min(bounce, 16), SDF_MIN_MARCH_STEPS)};
+	}
+
+	bool SphereTracing(const Ray& ray, float sdfStart, const rayFootprint& footprint, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		float t = 0.0f;
+		int sdfID = 0;
+		if (SphereMarch(ray, hitdist, sdfStart, footprint, t, sdfID)) {
+			hitdist = t - 1e-3f;
+			glm::vec3 p = ray.dir * t + ray.origin;
+			normal = CalculateSDFNormals(sdfID, p);
+			materialID = EvaluateSDFMATERIAL(sdfID, p);
+			lightID = -1.0f;
+			return true;
+		}
+		return false;
+	}
+
+	int ObjectIDOffset(int type) {
+		int offset = 0;
+		for (int i = 0; i < glm::min(type, 5); i++) {
+			offset += scene.ubo.numObjects[i];
+		}
+		if (type == 7) {
+			offset += scene.ubo.numPolynomials;
+		}
+		return offset;
+	}
+
+	void ObjectFromID(int objectID, int& type, int& index) {
+		type = 0;
+		index = objectID;
+		while ((type < 5) && (index >= scene.ubo.numObjects[type])) {
+			index -= scene.ubo.numObjects[type];
+			type++;
+		}
+		if (type == 5) {
+			index -= scene.ubo.numPolynomials;
+			type = 7;
+		}
+	}
+
+	bool ObjectIntersection(const Ray& ray, int type, int index, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		if (type == 0) {
+			return SphereIntersection(ray, scene.spheres[index], hitdist, normal, materialID, lightID);
+		}
+		if (type == 1) {
+			return PlaneIntersection(ray, scene.planes[index], hitdist, normal, materialID, lightID);
+		}
+		if (type == 2) {
+			const gpuBox& object = scene.boxes[index];
+			if (!BoundingSphere(ray, object.pos, object.boundingRadius2)) {
+				return false;
+			}
+			return BoxIntersection(ray, object, hitdist, normal, materialID, lightID);
+		}
+		if (type == 3) {
+			const gpuLens& object = scene.lenses[index];
+			int isOutside = 1;
+			if (!BoundingSphere(ray, object.pos, object.boundingRadius2)) {
+				return false;
+			}
+			return LensIntersection(ray, object, hitdist, normal, isOutside, materialID, lightID);
+		}
+		if (type == 4) {
+			const gpuCyclide& object = scene.cyclides[index];
+			if (!BoundingSphere(ray, object.pos, object.brad)) {
+				return false;
+			}
+			return DupinCyclide(ray, object, hitdist, normal, materialID, lightID);
+		}
+		if (type == 6) {
+			return PolynomialIntersection(ray, index, hitdist, normal, materialID, lightID);
+		}
+		if (type == 7) {
+			return RectIntersection(ray, scene.rects[index], hitdist, normal, materialID, lightID);
+		}
+		return false;
+	}
+
+	void BVHIntersection(const Ray& ray, float& hitdist, glm::vec3& normal, float& materialID, float& lightID, int& objectID) {
+		glm::vec3 invdir = 1.0f / ray.dir;
+		int stack[BVH_STACK_SIZE];
+		float stackDist[BVH_STACK_SIZE];
+		int stackSize = 0;
+
+		glm::vec2 tRoot = RayIntersectNode(ray.origin, invdir, scene.bvhNodes[0]);
+		if ((tRoot.x > tRoot.y) || (tRoot.y < 0.0f)) {
+			return;
+		}
+		stack[0] = 0;
+		stackDist[0] = tRoot.x;
+		stackSize = 1;
+
+		while (stackSize > 0) {
+			stackSize--;
+			if (stackDist[stackSize] > hitdist) {
+				continue;
+			}
+			const bvhNode& node = scene.bvhNodes[stack[stackSize]];
+
+			if (node.count > 0) {
+				for (int i = 0; i < node.count; i++) {
+					glm::ivec2 primitive = scene.bvhPrimitives[node.leftFirst + i];
+					if (ObjectIntersection(ray, primitive.x, primitive.y, hitdist, normal, materialID, lightID)) {
+						objectID = ObjectIDOffset(primitive.x) + primitive.y;
+					}
+				}
+				continue;
+			}
+
+			glm::vec2 tLeft = RayIntersectNode(ray.origin, invdir, scene.bvhNodes[node.leftFirst]);
+			glm::vec2 tRight = RayIntersectNode(ray.origin, invdir, scene.bvhNodes[node.leftFirst + 1]);
+			bool isHitLeft = (tLeft.x <= tLeft.y) && (tLeft.y >= 0.0f) && (tLeft.x < hitdist);
+			bool isHitRight = (tRight.x <= tRight.y) && (tRight.y >= 0.0f) && (tRight.x < hitdist);
+			if (isHitLeft && isHitRight) {
+				bool isLeftNear = tLeft.x <= tRight.x;
+				stack[stackSize] = isLeftNear ? (node.leftFirst + 1) : node.leftFirst;
+				stackDist[stackSize] = isLeftNear ? tRight.x : tLeft.x;
+				stackSize++;
+				stack[stackSize] = isLeftNear ? node.leftFirst : (node.leftFirst + 1);
+				stackDist[stackSize] = isLeftNear ? tLeft.x : tRight.x;
+				stackSize++;
+			} else if (isHitLeft) {
+				stack[stackSize] = node.leftFirst;
+				stackDist[stackSize] = tLeft.x;
+				stackSize++;
+			} else if (isHitRight) {
+				stack[stackSize] = node.leftFirst + 1;
+				stackDist[stackSize] = tRight.x;
+				stackSize++;
+			}
+		}
+	}
+
+	glm::vec2 HeightfieldRange(const gpuHeightfield& object, int level, glm::ivec2 cell) {
+		int n = object.resolution;
+		int cells = n >> level;
+		int index = object.mipOffset + 2 * ((4 * (n * n - cells * cells)) / 3 + cell.x + cells * cell.y);
+		return glm::vec2(scene.heightfieldData[index], scene.heightfieldData[index + 1]);
+	}
+
+	float HeightfieldHeight(const gpuHeightfield& object, glm::ivec2 vertex) {
+		return scene.heightfieldData[object.heightOffset + vertex.x + (object.resolution + 1) * vertex.y];
+	}
+
+	static bool TriangleIntersection(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& t, glm::vec3& normal) {
+		glm::vec3 e1 = v1 - v0;
+		glm::vec3 e2 = v2 - v0;
+		glm::vec3 p = glm::cross(dir, e2);
+		float det = glm::dot(e1, p);
+		if (glm::abs(det) < 1e-12f) {
+			return false;
+		}
+		float invDet = 1.0f / det;
+		glm::vec3 s = origin - v0;
+		float u = glm::dot(s, p) * invDet;
+		glm::vec3 q = glm::cross(s, e1);
+		float v = glm::dot(dir, q) * invDet;
+		float tHit = glm::dot(e2, q) * invDet;
+		if ((u < 0.0f) || (v < 0.0f) || ((u + v) > 1.0f) || (tHit < 1e-4f) || (tHit >= t)) {
+			return false;
+		}
+		t = tHit;
+		normal = glm::cross(e1, e2);
+		return true;
+	}
+
+	bool HeightfieldIntersection(const Ray& ray, const gpuHeightfield& object, float& hitdist, glm::vec3& normal, float& materialID, float& lightID) {
+		int n = object.resolution;
+		glm::vec3 scale = glm::vec3((float)n / object.size.x, 1.0f, (float)n / object.size.z);
+		glm::vec3 origin = (ray.origin - object.pos + glm::vec3(0.5f * object.size.x, 0.0f, 0.5f * object.size.z)) * scale;
+		glm::vec3 dir = ray.dir * scale;
+		for (int i = 0; i < 3; i++) {
+			dir[i] = (dir[i] == 0.0f) ? 1e-20f : dir[i];
+		}
+		glm::vec3 invdir = 1.0f / dir;
+		glm::vec2 rootRange = HeightfieldRange(object, object.levels, glm::ivec2(0));
+		glm::vec2 tRange = RayIntersectBounds(origin, invdir, glm::vec3(0.0f, rootRange.x, 0.0f), glm::vec3((float)n, rootRange.y, (float)n));
+		float t = glm::max(tRange.x, 0.0f);
+		float tEnd = glm::min(tRange.y, hitdist);
+		glm::vec2 nudge = glm::sign(glm::vec2(dir.x, dir.z)) * HEIGHTFIELD_NUDGE;
+		int level = object.levels;
+		int maxSteps = HEIGHTFIELD_STEPS_PER_CELL * (n + object.levels);
+		for (int i = 0; (i < maxSteps) && (t < tEnd); i++) {
+			glm::vec3 p = dir * t + origin;
+			int cellSize = 1 << level;
+			glm::ivec2 cell = glm::ivec2(glm::floor((glm::vec2(p.x, p.z) + nudge) / (float)cellSize));
+			if (glm::any(glm::lessThan(cell, glm::ivec2(0))) || glm::any(glm::greaterThanEqual(cell, glm::ivec2(n >> level)))) {
+				return false;
+			}
+			glm::vec2 cellMin = glm::vec2(cell * cellSize);
+			glm::vec2 originXZ = glm::vec2(origin.x, origin.z);
+			glm::vec2 invdirXZ = glm::vec2(invdir.x, invdir.z);
+			glm::vec2 tSides = glm::max((cellMin - originXZ) * invdirXZ, (cellMin + (float)cellSize - originXZ) * invdirXZ);
+			float tExit = glm::min(glm::min(tSides.x, tSides.y), tEnd);
+			glm::vec2 range = HeightfieldRange(object, level, cell);
+			float yEnter = p.y;
+			float yExit = dir.y * tExit + origin.y;
+			if ((glm::max(yEnter, yExit) < range.x) || (glm::min(yEnter, yExit) > range.y)) {
+				t = glm::max(tExit, t);
+				level = glm::min(level + 1, object.levels);
+				continue;
+			}
+			if (level > 0) {
+				level--;
+				continue;
+			}
+			glm::vec3 v00 = glm::vec3(cell.x, HeightfieldHeight(object, cell), cell.y);
+			glm::vec3 v10 = glm::vec3(cell.x + 1, HeightfieldHeight(object, cell + glm::ivec2(1, 0)), cell.y);
+			glm::vec3 v01 = glm::vec3(cell.x, HeightfieldHeight(object, cell + glm::ivec2(0, 1)), cell.y + 1);
+			glm::vec3 v11 = glm::vec3(cell.x + 1, HeightfieldHeight(object, cell + glm::ivec2(1, 1)), cell.y + 1);
+			float tHit = hitdist;
+			glm::vec3 gridNormal = glm::vec3(0.0f);
+			bool isHit = TriangleIntersection(origin, dir, v00, v11, v10, tHit, gridNormal);
+			isHit = TriangleIntersection(origin, dir, v00, v01, v11, tHit, gridNormal) || isHit;
+			if (isHit) {
+				hitdist = tHit;
+				normal = glm::normalize(gridNormal * scale);
+				normal = glm::faceforward(normal, ray.dir, normal);
+				materialID = (float)object.materialID;
+				lightID = -1.0f;
+				return true;
+			}
+			t = glm::max(tExit, t);
+			level = glm::min(level + 1, object.levels);
+		}
+		return false;
+	}
+
+	float AnalyticIntersection(const Ray& ray, glm::vec3& normal, float& materialID, float& lightID, int& objectID) {
+		float hitdist = MAXDIST;
+		objectID = -1;
+
+		for (int i = 0; i < scene.ubo.numObjects[1]; i++) {
+			if (ObjectIntersection(ray, 1, i, hitdist, normal, materialID, lightID)) {
+				objectID = scene.ubo.numObjects[0] + i;
+			}
+		}
+
+		if (scene.ubo.numObjects[7] > 0) {
+			BVHIntersection(ray, hitdist, normal, materialID, lightID, objectID);
+		} else {
+			for (int type = 0; type < 5; type++) {
+				if (type == 1) {
+					continue;
+				}
+				for (int i = 0; i < scene.ubo.numObjects[type]; i++) {
+					if (ObjectIntersection(ray, type, i, hitdist, normal, materialID, lightID)) {
+						objectID = ObjectIDOffset(type) + i;
+					}
+				}
+			}
+			for (int i = 0; i < scene.ubo.numPolynomials; i++) {
+				if (ObjectIntersection(ray, 6, i, hitdist, normal, materialID, lightID)) {
+					objectID = ObjectIDOffset(6) + i;
+				}
+			}
+			for (int i = 0; i < scene.ubo.numRects; i++) {
+				if (ObjectIntersection(ray, 7, i, hitdist, normal, materialID, lightID)) {
+					objectID = ObjectIDOffset(7) + i;
+				}
+			}
+		}
+
+		for (int i = 0; i < scene.ubo.numHeightfields; i++) {
+			if (HeightfieldIntersection(ray, scene.heightfields[i], hitdist, normal, materialID, lightID)) {
+				objectID = -1;
+			}
+		}
+
+		return hitdist;
+	}
+
+	float Intersection(const Ray& ray, float sdfStart, const rayFootprint& footprint, glm::vec3& normal, float& materialID, float& lightID, int& objectID) {
+		float hitdist = AnalyticIntersection(ray, normal, materialID, lightID, objectID);
+		if (SphereTracing(ray, sdfStart, footprint, hitdist, normal, materialID, lightID)) {
+			objectID = -1;
+		}
+		return hitdist;
+	}
+
+	float ScalarKernel(int kernel, const Ray& ray) {
+		// Scalar Kernels Of Packet Benchmark, Each Runs Over Every Object Of Its Type
+		float hitdist = MAXDIST;
+		glm::vec3 normal = glm::vec3(0.0f);
+		float materialID = 0.0f;
+		float lightID = -1.0f;
+		int objectID = -1;
+		if (kernel == PACKET_KERNEL_SPHERE) {
+			for (const gpuSphere& object : scene.spheres) {
+				SphereIntersection(ray, object, hitdist, normal, materialID, lightID);
+			}
+		} else if (kernel == PACKET_KERNEL_PLANE) {
+			for (const gpuPlane& object : scene.planes) {
+				PlaneIntersection(ray, object, hitdist, normal, materialID, lightID);
+			}
+		} else if (kernel == PACKET_KERNEL_BOX) {
+			for (int i = 0; i < (int)scene.boxes.size(); i++) {
+				ObjectIntersection(ray, 2, i, hitdist, normal, materialID, lightID);
+			}
+		} else if (kernel == PACKET_KERNEL_AABB) {
+			glm::vec3 invdir = 1.0f / ray.dir;
+			for (const bvhNode& node : scene.bvhNodes) {
+				glm::vec2 tNode = RayIntersectNode(ray.origin, invdir, node);
+				if ((tNode.x <= tNode.y) && (tNode.y >= 0.0f)) {
+					hitdist = glm::min(hitdist, tNode.x);
+				}
+			}
+		} else if (kernel == PACKET_KERNEL_CYCLIDE) {
+			for (int i = 0; i < (int)scene.cyclides.size(); i++) {
+				ObjectIntersection(ray, 4, i, hitdist, normal, materialID, lightID);
+			}
+		} else if (kernel == PACKET_KERNEL_BVH) {
+			if (scene.ubo.numObjects[7] > 0) {
+				BVHIntersection(ray, hitdist, normal, materialID, lightID, objectID);
+			}
+		} else {
+			hitdist = AnalyticIntersection(ray, normal, materialID, lightID, objectID);
+		}
+		return hitdist;
+	}
+
+#ifdef CPU_PACKETS
+	// Packet Kernels Follow The Scalar Functions Above Lane By Lane, Lanes Only Take The Results Of Hits Closer Than Their Own
+	template<int N>
+	PACKET_INLINE PacketMask<N> PacketBoundingSphere(const RayPacket<N>& ray, const glm::vec3& pos, float radius2) {
+		PacketVec3<N> localorigin = ray.origin - pos;
+		PacketFloat<N> b = Dot(ray.dir, localorigin);
+		PacketFloat<N> c = Dot(localorigin, localorigin) - radius2;
+		return ray.active & (b * b >= c) & ((b < 0.0f) | (c < 0.0f));
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketRayIntersectBounds(const RayPacket<N>& ray, const glm::vec3& boundsMin, const glm::vec3& boundsMax, PacketFloat<N>& t1, PacketFloat<N>& t2) {
+		PacketVec3<N> tMin = (Splat<N>(boundsMin) + PacketVec3<N>{-ray.origin.x, -ray.origin.y, -ray.origin.z}) * ray.invdir;
+		PacketVec3<N> tMax = (Splat<N>(boundsMax) + PacketVec3<N>{-ray.origin.x, -ray.origin.y, -ray.origin.z}) * ray.invdir;
+		t1 = Max(Max(Min(tMin.x, tMax.x), Min(tMin.y, tMax.y)), Min(tMin.z, tMax.z));
+		t2 = Min(Min(Max(tMin.x, tMax.x), Max(tMin.y, tMax.y)), Max(tMin.z, tMax.z));
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketRayIntersectNode(const RayPacket<N>& ray, const bvhNode& node, PacketFloat<N>& t1, PacketFloat<N>& t2) {
+		PacketRayIntersectBounds(ray, glm::vec3(node.boundsMin[0], node.boundsMin[1], node.boundsMin[2]), glm::vec3(node.boundsMax[0], node.boundsMax[1], node.boundsMax[2]), t1, t2);
+	}
+
+	template<int N>
+	PACKET_INLINE void TakeHits(const PacketMask<N>& isHit, const PacketFloat<N>& t, const PacketVec3<N>& normal, float materialID, float lightID, HitPacket<N>& hit) {
+		hit.hitdist = Select(isHit, t, hit.hitdist);
+		hit.normal = Select(isHit, normal, hit.normal);
+		hit.materialID = Select(isHit, Splat<N>(materialID), hit.materialID);
+		hit.lightID = Select(isHit, Splat<N>(lightID), hit.lightID);
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketSphereIntersection(const RayPacket<N>& ray, const gpuSphere& object, HitPacket<N>& hit) {
+		PacketVec3<N> localorigin = ray.origin - object.pos;
+		PacketFloat<N> b = 2.0f * Dot(ray.dir, localorigin);
+		PacketFloat<N> c = Dot(localorigin, localorigin) - (object.radius * object.radius);
+		PacketFloat<N> discriminant = b * b - 4.0f * c;
+		PacketMask<N> isHit = ray.active & (discriminant >= 0.0f);
+		if (!Any(isHit)) {
+			return;
+		}
+		PacketFloat<N> sqrtD = Sqrt(Max(discriminant, Splat<N>(0.0f)));
+		PacketFloat<N> t1 = (-b - sqrtD) * 0.5f;
+		PacketFloat<N> t2 = (-b + sqrtD) * 0.5f;
+		PacketMask<N> isOutside = t1 > 0.0f;
+		PacketFloat<N> t = Select(isOutside, t1, t2);
+		isHit = isHit & (t >= 1e-4f) & (t < hit.hitdist);
+		if (!Any(isHit)) {
+			return;
+		}
+		PacketVec3<N> normal = Normalize((ray.dir * t + localorigin) * Select(isOutside, Splat<N>(1.0f), Splat<N>(-1.0f)));
+		TakeHits(isHit, t, normal, (float)object.materialID, (float)object.lightID, hit);
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketPlaneIntersection(const RayPacket<N>& ray, const gpuPlane& object, HitPacket<N>& hit) {
+		PacketFloat<N> t = (object.pos.y - ray.origin.y) / ray.dir.y;
+		PacketMask<N> isHit = ray.active & (t >= 1e-4f) & (t < hit.hitdist);
+		if (!Any(isHit)) {
+			return;
+		}
+		PacketVec3<N> normal = PacketVec3<N>{Splat<N>(0.0f), Select(ray.dir.y < 0.0f, Splat<N>(1.0f), Splat<N>(-1.0f)), Splat<N>(0.0f)};
+		TakeHits(isHit, t, normal, (float)object.materialID, (float)object.lightID, hit);
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketBoxIntersection(const RayPacket<N>& ray, const gpuBox& object, HitPacket<N>& hit) {
+		PacketMask<N> isHit = PacketBoundingSphere(ray, object.pos, object.boundingRadius2);
+		if (!Any(isHit)) {
+			return;
+		}
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		PacketVec3<N> localorigin = MatrixTimesPacket(worldToLocal, ray.origin - object.pos);
+		PacketVec3<N> dir = MatrixTimesPacket(worldToLocal, ray.dir);
+		PacketVec3<N> invdir = PacketVec3<N>{1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z};
+		PacketVec3<N> tMin = PacketVec3<N>{(object.size.x * -0.5f - localorigin.x) * invdir.x, (object.size.y * -0.5f - localorigin.y) * invdir.y, (object.size.z * -0.5f - localorigin.z) * invdir.z};
+		PacketVec3<N> tMax = PacketVec3<N>{(object.size.x * 0.5f - localorigin.x) * invdir.x, (object.size.y * 0.5f - localorigin.y) * invdir.y, (object.size.z * 0.5f - localorigin.z) * invdir.z};
+		PacketFloat<N> t1 = Max(Max(Min(tMin.x, tMax.x), Min(tMin.y, tMax.y)), Min(tMin.z, tMax.z));
+		PacketFloat<N> t2 = Min(Min(Max(tMin.x, tMax.x), Max(tMin.y, tMax.y)), Max(tMin.z, tMax.z));
+		PacketFloat<N> t = Select(t1 < 0.0f, t2, t1);
+		isHit = isHit & (t1 <= t2) & (t >= 1e-4f) & (t < hit.hitdist);
+		if (!Any(isHit)) {
+			return;
+		}
+		PacketFloat<N> px = Abs((localorigin.x + dir.x * t) / object.size.x);
+		PacketFloat<N> py = Abs((localorigin.y + dir.y * t) / object.size.y);
+		PacketFloat<N> pz = Abs((localorigin.z + dir.z * t) / object.size.z);
+		PacketFloat<N> pMax = Max(Max(px, py), pz);
+		PacketFloat<N> zero = Splat<N>(0.0f);
+		PacketVec3<N> localNormal = PacketVec3<N>{Select(px >= pMax, -Sign(dir.x), zero), Select(py >= pMax, -Sign(dir.y), zero), Select(pz >= pMax, -Sign(dir.z), zero)};
+		TakeHits(isHit, t, PacketTimesMatrix(localNormal, worldToLocal), (float)object.materialID, (float)object.lightID, hit);
+	}
+
+	template<int N>
+	PACKET_INLINE PacketFloat<N> PacketSolveCubicRoot(const PacketFloat<N>& b, const PacketFloat<N>& c, const PacketFloat<N>& d) {
+		// Largest Root Of SolveCubic, Which Is The Only One SolveQuartic Uses, Both Branches Are Taken And Lanes Pick One
+		const float ONEBYTHREE = 0.3333333f;
+		PacketFloat<N> bdiv3 = b * ONEBYTHREE;
+		PacketFloat<N> Q = c * ONEBYTHREE - bdiv3 * bdiv3;
+		PacketFloat<N> R = 0.5f * bdiv3 * c - bdiv3 * bdiv3 * bdiv3 - 0.5f * d;
+		PacketFloat<N> D = Q * Q * Q + R * R;
+		PacketMask<N> isOneRoot = D > 0.0f;
+		PacketFloat<N> sqrtD = Sqrt(Max(D, Splat<N>(0.0f)));
+		PacketFloat<N> oneRoot = Cbrt(R + sqrtD) + Cbrt(R - sqrtD) - bdiv3;
+		PacketFloat<N> sqrtnegQ = Sqrt(Max(-Q, Splat<N>(0.0f)));
+		PacketFloat<N> cosTheta = Max(Min(R / (sqrtnegQ * sqrtnegQ * sqrtnegQ), Splat<N>(1.0f)), Splat<N>(-1.0f));
+		PacketFloat<N> threeRoots = 2.0f * sqrtnegQ * Cos(Acos(cosTheta) * ONEBYTHREE) - bdiv3;
+		PacketFloat<N> root = Select(isOneRoot, oneRoot, threeRoots);
+		for (int i = 0; i < 2; i++) {
+			root = root - (root * (root * (root + b) + c) + d) / (root * (root * 3.0f + 2.0f * b) + c);
+		}
+		return root;
+	}
+
+	template<int N>
+	PACKET_INLINE PacketMask<N> PacketSolveQuartic(const PacketFloat<N>& a, const PacketFloat<N>& b, const PacketFloat<N>& c, const PacketFloat<N>& d, const PacketFloat<N>& e, PacketFloat<N> roots[4], PacketMask<N> isReal[2]) {
+		// Same As SolveQuartic, isReal Holds Lanes With Real Roots 0 And 1, Then 2 And 3
+		PacketFloat<N> inva = 1.0f / a;
+		PacketFloat<N> inva2 = inva * 0.5f;
+		PacketFloat<N> inva2a2 = inva2 * inva2;
+		PacketFloat<N> bb = b * b;
+		PacketFloat<N> p = -1.5f * bb * inva2a2 + c * inva;
+		PacketFloat<N> q = bb * b * inva2a2 * inva2 - b * c * inva * inva2 + d * inva;
+		PacketFloat<N> r = -0.1875f * bb * bb * inva2a2 * inva2a2 + 0.5f * c * bb * inva2a2 * inva2 - b * d * inva2a2 + e * inva;
+		PacketFloat<N> s = PacketSolveCubicRoot(0.5f * -p, -r, 0.5f * p * r - 0.125f * q * q);
+		PacketFloat<N> s2subp = 2.0f * s - p;
+		PacketMask<N> isAnyReal = s2subp >= 0.0f;
+		PacketFloat<N> invs2subp = -2.0f * s - p;
+		PacketFloat<N> sqrts2subp = Sqrt(Max(s2subp, Splat<N>(0.0f)));
+		PacketFloat<N> q2divsqrt = 2.0f * q / sqrts2subp;
+		PacketFloat<N> invaddq2div = invs2subp + q2divsqrt;
+		PacketFloat<N> invsubq2div = invs2subp - q2divsqrt;
+		PacketFloat<N> bdiv4a = 0.25f * inva * b;
+		PacketFloat<N> sqrtadd = Sqrt(Max(invaddq2div, Splat<N>(0.0f)));
+		PacketFloat<N> sqrtsub = Sqrt(Max(invsubq2div, Splat<N>(0.0f)));
+		roots[0] = 0.5f * (-sqrts2subp + sqrtadd) - bdiv4a;
+		roots[1] = 0.5f * (-sqrts2subp - sqrtadd) - bdiv4a;
+		roots[2] = 0.5f * (sqrts2subp + sqrtsub) - bdiv4a;
+		roots[3] = 0.5f * (sqrts2subp - sqrtsub) - bdiv4a;
+		for (int i = 0; i < 4; i++) {
+			PacketFloat<N> x = roots[i];
+			roots[i] = x - (x * (x * (x * (x * a + b) + c) + d) + e) / (x * (x * (x * (a * 4.0f) + b * 3.0f) + c * 2.0f) + d);
+		}
+		isReal[0] = isAnyReal & (invaddq2div >= 0.0f);
+		isReal[1] = isAnyReal & (invsubq2div >= 0.0f);
+		return isReal[0] | isReal[1];
+	}
+
+	template<int N>
+	PACKET_INLINE PacketMask<N> PacketQuarticMayHaveRoot(const PacketFloat<N>& a, const PacketFloat<N>& b, const PacketFloat<N>& c, const PacketFloat<N>& d, const PacketFloat<N>& e, const PacketFloat<N>& tStart, const PacketFloat<N>& tEnd) {
+		PacketFloat<N> t = tStart;
+		PacketFloat<N> h = tEnd - tStart;
+		PacketFloat<N> c0 = (((a * t + b) * t + c) * t + d) * t + e;
+		PacketFloat<N> c1 = (((4.0f * a * t + 3.0f * b) * t + 2.0f * c) * t + d) * h;
+		PacketFloat<N> c2 = ((6.0f * a * t + 3.0f * b) * t + c) * h * h;
+		PacketFloat<N> c3 = (4.0f * a * t + b) * h * h * h;
+		PacketFloat<N> c4 = a * h * h * h * h;
+		PacketFloat<N> bernstein[4] = {0.25f * c1 + c0, c0 + 0.5f * c1 + c2 / 6.0f, c0 + 0.75f * c1 + 0.5f * c2 + 0.25f * c3, c0 + c1 + c2 + c3 + c4};
+		PacketFloat<N> bernsteinMin = Min(Min(Min(bernstein[0], bernstein[1]), Min(bernstein[2], bernstein[3])), c0);
+		PacketFloat<N> bernsteinMax = Max(Max(Max(bernstein[0], bernstein[1]), Max(bernstein[2], bernstein[3])), c0);
+		PacketFloat<N> T = Max(Abs(tStart), Abs(tEnd));
+		PacketFloat<N> tolerance = 1e-5f * ((((Abs(a) * T + Abs(b)) * T + Abs(c)) * T + Abs(d)) * T + Abs(e));
+		return (bernsteinMin <= tolerance) & (bernsteinMax >= -tolerance);
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketDupinCyclide(const RayPacket<N>& ray, const gpuCyclide& object, HitPacket<N>& hit) {
+		PacketMask<N> isHit = PacketBoundingSphere(ray, object.pos, object.brad);
+		if (!Any(isHit)) {
+			return;
+		}
+		bool isCount = (pc.isCountMarchSteps != 0);
+		if (isCount) {
+			marchStats[3] += CountLanes(isHit);
+		}
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		PacketVec3<N> localOrigin = MatrixTimesPacket(worldToLocal, ray.origin - object.pos) * object.invScale;
+		PacketVec3<N> localDir = MatrixTimesPacket(worldToLocal, ray.dir) * object.invScale;
+		PacketVec3<N> o = PacketVec3<N>{localOrigin.x, localOrigin.z, localOrigin.y};
+		PacketVec3<N> d = PacketVec3<N>{localDir.x, localDir.z, localDir.y};
+		RayPacket<N> localRay = RayPacket<N>{o, d, PacketVec3<N>{1.0f / d.x, 1.0f / d.y, 1.0f / d.z}, isHit};
+		PacketFloat<N> tStart;
+		PacketFloat<N> tEnd;
+		PacketRayIntersectBounds(localRay, object.boundsMin, object.boundsMax, tStart, tEnd);
+		tStart = Max(tStart, Splat<N>(0.0f));
+		tEnd = Min(tEnd, hit.hitdist);
+		isHit = isHit & (tStart <= tEnd);
+		if (!Any(isHit)) {
+			return;
+		}
+		float a = object.a;
+		float b = object.b;
+		float c = object.c;
+		float e = object.d;
+		PacketVec3<N> oo = o * o;
+		PacketVec3<N> dd = d * d;
+		PacketVec3<N> od = o * d;
+		PacketVec3<N> ddYZX = PacketVec3<N>{dd.y, dd.z, dd.x};
+		PacketVec3<N> ddZXY = PacketVec3<N>{dd.z, dd.x, dd.y};
+		PacketVec3<N> odYZX = PacketVec3<N>{od.y, od.z, od.x};
+		PacketVec3<N> odZXY = PacketVec3<N>{od.z, od.x, od.y};
+		PacketVec3<N> ooYZX = PacketVec3<N>{oo.y, oo.z, oo.x};
+		PacketFloat<N> a4 = Dot(dd, dd) + 2.0f * Dot(dd, ddYZX);
+		PacketFloat<N> a3 = 4.0f * (Dot(o, dd * d) + Dot(od, ddYZX) + Dot(od, ddZXY));
+		PacketFloat<N> a2 = 6.0f * Dot(oo, dd) + 8.0f * Dot(od, odYZX) + 2.0f * (Dot(oo, ddYZX) + Dot(oo, ddZXY)) + 2.0f * (b * b - e * e) * Dot(d, d) - 4.0f * (a * a * dd.x + b * b * dd.y);
+		PacketFloat<N> a1 = 4.0f * (Dot(oo * o, d) + Dot(oo, odYZX) + Dot(oo, odZXY) + 2.0f * a * c * e * d.x + (b * b - e * e) * Dot(o, d) - 2.0f * (a * a * od.x + b * b * od.y));
+		PacketFloat<N> a0 = Dot(oo, oo) + 2.0f * Dot(oo, ooYZX) + b * b * b * b + e * e * e * e - 2.0f * b * b * e * e - 4.0f * c * c * e * e + 8.0f * a * c * e * o.x + 2.0f * (b * b - e * e) * Dot(o, o) - 4.0f * (a * a * oo.x + b * b * oo.y);
+
+		if (pc.isCyclideIntervalTest != 0) {
+			isHit = isHit & PacketQuarticMayHaveRoot(a4, a3, a2, a1, a0, tStart, tEnd);
+			if (!Any(isHit)) {
+				return;
+			}
+		}
+
+		PacketFloat<N> roots[4];
+		PacketMask<N> isReal[2];
+		PacketSolveQuartic(a4, a3, a2, a1, a0, roots, isReal);
+		PacketFloat<N> t = Splat<N>(1e6f);
+		for (int i = 0; i < 4; i++) {
+			t = Select(isReal[i / 2] & (roots[i] < t) & (roots[i] > 0.0f) & (roots[i] >= tStart) & (roots[i] <= tEnd), roots[i], t);
+		}
+		if (isCount) {
+			marchStats[4] += CountLanes(isHit);
+			marchStats[5] += CountLanes(isHit & (t >= hit.hitdist));
+		}
+
+		isHit = isHit & (t < hit.hitdist);
+		if (!Any(isHit)) {
+			return;
+		}
+		PacketFloat<N> x = o.x + d.x * t;
+		PacketFloat<N> y = o.y + d.y * t;
+		PacketFloat<N> z = o.z + d.z * t;
+		PacketFloat<N> term1 = x * x + y * y + z * z + b * b - e * e;
+		PacketVec3<N> normal = PacketVec3<N>{4.0f * (x * term1 - 2.0f * a * (a * x - c * e)), 4.0f * z * term1, 4.0f * y * (term1 - 2.0f * b * b)};
+		TakeHits(isHit, t, Normalize(normal), (float)object.materialID, (float)object.lightID, hit);
+	}
+
+	template<int N>
+	void LaneIntersection(const RayPacket<N>& ray, int type, int index, HitPacket<N>& hit) {
+		// Objects Without Packet Kernel Are Intersected By The Scalar Port, One Active Lane At A Time
+		for (int i = 0; i < N; i++) {
+			if (ray.active.v[i] == 0) {
+				continue;
+			}
+			Ray laneRay = Ray{glm::vec3(ray.origin.x.v[i], ray.origin.y.v[i], ray.origin.z.v[i]), glm::vec3(ray.dir.x.v[i], ray.dir.y.v[i], ray.dir.z.v[i])};
+			float hitdist = hit.hitdist.v[i];
+			glm::vec3 normal = glm::vec3(0.0f);
+			float materialID = 0.0f;
+			float lightID = -1.0f;
+			bool isHit = false;
+			if (type == 5) {
+				isHit = HeightfieldIntersection(laneRay, scene.heightfields[index], hitdist, normal, materialID, lightID);
+			} else {
+				isHit = ObjectIntersection(laneRay, type, index, hitdist, normal, materialID, lightID);
+			}
+			if (isHit) {
+				hit.hitdist.v[i] = hitdist;
+				hit.normal.x.v[i] = normal.x;
+				hit.normal.y.v[i] = normal.y;
+				hit.normal.z.v[i] = normal.z;
+				hit.materialID.v[i] = materialID;
+				hit.lightID.v[i] = lightID;
+			}
+		}
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketObjectIntersection(const RayPacket<N>& ray, int type, int index, HitPacket<N>& hit) {
+		if (type == 0) {
+			PacketSphereIntersection(ray, scene.spheres[index], hit);
+		} else if (type == 1) {
+			PacketPlaneIntersection(ray, scene.planes[index], hit);
+		} else if (type == 2) {
+			PacketBoxIntersection(ray, scene.boxes[index], hit);
+		} else if (type == 4) {
+			PacketDupinCyclide(ray, scene.cyclides[index], hit);
+		} else {
+			LaneIntersection(ray, type, index, hit);
+		}
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketBVHIntersection(const RayPacket<N>& ray, HitPacket<N>& hit) {
+		// Packet Opens A Node If Any Active Lane Enters It Before Its Closest Hit, Entry Distances Of Other Lanes Are Infinite
+		PacketFloat<N> noEntry = Splat<N>(std::numeric_limits<float>::infinity());
+		int stack[BVH_STACK_SIZE];
+		PacketFloat<N> stackDist[BVH_STACK_SIZE];
+		int stackSize = 0;
+
+		PacketFloat<N> t1;
+		PacketFloat<N> t2;
+		PacketRayIntersectNode(ray, scene.bvhNodes[0], t1, t2);
+		PacketMask<N> isHitRoot = ray.active & (t1 <= t2) & (t2 >= 0.0f);
+		if (!Any(isHitRoot)) {
+			return;
+		}
+		stack[0] = 0;
+		stackDist[0] = Select(isHitRoot, t1, noEntry);
+		stackSize = 1;
+
+		while (stackSize > 0) {
+			stackSize--;
+			if (!Any(stackDist[stackSize] <= hit.hitdist)) {
+				continue;
+			}
+			const bvhNode& node = scene.bvhNodes[stack[stackSize]];
+
+			if (node.count > 0) {
+				for (int i = 0; i < node.count; i++) {
+					glm::ivec2 primitive = scene.bvhPrimitives[node.leftFirst + i];
+					PacketObjectIntersection(ray, primitive.x, primitive.y, hit);
+				}
+				continue;
+			}
+
+			PacketFloat<N> tLeft1;
+			PacketFloat<N> tLeft2;
+			PacketFloat<N> tRight1;
+			PacketFloat<N> tRight2;
+			PacketRayIntersectNode(ray, scene.bvhNodes[node.leftFirst], tLeft1, tLeft2);
+			PacketRayIntersectNode(ray, scene.bvhNodes[node.leftFirst + 1], tRight1, tRight2);
+			PacketMask<N> isHitLeft = ray.active & (tLeft1 <= tLeft2) & (tLeft2 >= 0.0f) & (tLeft1 < hit.hitdist);
+			PacketMask<N> isHitRight = ray.active & (tRight1 <= tRight2) & (tRight2 >= 0.0f) & (tRight1 < hit.hitdist);
+			bool isAnyLeft = Any(isHitLeft);
+			bool isAnyRight = Any(isHitRight);
+			PacketFloat<N> leftDist = Select(isHitLeft, tLeft1, noEntry);
+			PacketFloat<N> rightDist = Select(isHitRight, tRight1, noEntry);
+			if (isAnyLeft && isAnyRight) {
+				// Child Nearer For Most Lanes Is Opened First
+				bool isLeftNear = CountLanes(isHitLeft & (leftDist <= rightDist)) >= CountLanes(isHitRight & (rightDist < leftDist));
+				stack[stackSize] = isLeftNear ? (node.leftFirst + 1) : node.leftFirst;
+				stackDist[stackSize] = isLeftNear ? rightDist : leftDist;
+				stackSize++;
+				stack[stackSize] = isLeftNear ? node.leftFirst : (node.leftFirst + 1);
+				stackDist[stackSize] = isLeftNear ? leftDist : rightDist;
+				stackSize++;
+			} else if (isAnyLeft) {
+				stack[stackSize] = node.leftFirst;
+				stackDist[stackSize] = leftDist;
+				stackSize++;
+			} else if (isAnyRight) {
+				stack[stackSize] = node.leftFirst + 1;
+				stackDist[stackSize] = rightDist;
+				stackSize++;
+			}
+		}
+	}
+
+	template<int N>
+	PACKET_INLINE void PacketAnalyticIntersection(const RayPacket<N>& ray, HitPacket<N>& hit) {
+		// Same As AnalyticIntersection For A Packet Of Rays
+		for (int i = 0; i < scene.ubo.numObjects[1]; i++) {
+			PacketPlaneIntersection(ray, scene.planes[i], hit);
+		}
+
+		if (scene.ubo.numObjects[7] > 0) {
+			PacketBVHIntersection(ray, hit);
+		} else {
+			for (int type = 0; type < 5; type++) {
+				if (type == 1) {
+					continue;
+				}
+				for (int i = 0; i < scene.ubo.numObjects[type]; i++) {
+					PacketObjectIntersection(ray, type, i, hit);
+				}
+			}
+			for (int i = 0; i < scene.ubo.numPolynomials; i++) {
+				LaneIntersection(ray, 6, i, hit);
+			}
+			for (int i = 0; i < scene.ubo.numRects; i++) {
+				LaneIntersection(ray, 7, i, hit);
+			}
+		}
+
+		for (int i = 0; i < scene.ubo.numHeightfields; i++) {
+			LaneIntersection(ray, 5, i, hit);
+		}
+	}
+
+	template<int N>
+	PACKET_INLINE void RunPacketKernel(int kernel, const RayPacket<N>& ray, HitPacket<N>& hit) {
+		// Kernels Of Packet Benchmark, Each Runs Over Every Object Of Its Type
+		if (kernel == PACKET_KERNEL_SPHERE) {
+			for (const gpuSphere& object : scene.spheres) {
+				PacketSphereIntersection(ray, object, hit);
+			}
+		} else if (kernel == PACKET_KERNEL_PLANE) {
+			for (const gpuPlane& object : scene.planes) {
+				PacketPlaneIntersection(ray, object, hit);
+			}
+		} else if (kernel == PACKET_KERNEL_BOX) {
+			for (const gpuBox& object : scene.boxes) {
+				PacketBoxIntersection(ray, object, hit);
+			}
+		} else if (kernel == PACKET_KERNEL_AABB) {
+			// Nearest Entry Into Any Node Stands In For The Hit, So Tests Can't Be Skipped
+			for (const bvhNode& node : scene.bvhNodes) {
+				PacketFloat<N> t1;
+				PacketFloat<N> t2;
+				PacketRayIntersectNode(ray, node, t1, t2);
+				hit.hitdist = Select(ray.active & (t1 <= t2) & (t2 >= 0.0f), Min(hit.hitdist, t1), hit.hitdist);
+			}
+		} else if (kernel == PACKET_KERNEL_CYCLIDE) {
+			for (const gpuCyclide& object : scene.cyclides) {
+				PacketDupinCyclide(ray, object, hit);
+			}
+		} else if (kernel == PACKET_KERNEL_BVH) {
+			if (scene.ubo.numObjects[7] > 0) {
+				PacketBVHIntersection(ray, hit);
+			}
+		} else {
+			PacketAnalyticIntersection(ray, hit);
+		}
+	}
+
+	// Entry Points Built For Each Instruction Set, Packet Kernels Are Inlined Into Them
+	PACKET_AVX2 void PacketKernel(int kernel, const RayPacket<8>& ray, HitPacket<8>& hit) {
+		RunPacketKernel(kernel, ray, hit);
+	}
+
+	PACKET_AVX512 void PacketKernel(int kernel, const RayPacket<16>& ray, HitPacket<16>& hit) {
+		RunPacketKernel(kernel, ray, hit);
+	}
+
+	template<int N>
+	void MakeRayPacket(const Ray* rays, int count, RayPacket<N>& packet, HitPacket<N>& hit) {
+		// Lanes Past count Repeat The First Ray And Stay Inactive
+		for (int i = 0; i < N; i++) {
+			const Ray& ray = rays[(i < count) ? i : 0];
+			packet.origin.x.v[i] = ray.origin.x;
+			packet.origin.y.v[i] = ray.origin.y;
+			packet.origin.z.v[i] = ray.origin.z;
+			packet.dir.x.v[i] = ray.dir.x;
+			packet.dir.y.v[i] = ray.dir.y;
+			packet.dir.z.v[i] = ray.dir.z;
+			packet.invdir.x.v[i] = 1.0f / ray.dir.x;
+			packet.invdir.y.v[i] = 1.0f / ray.dir.y;
+			packet.invdir.z.v[i] = 1.0f / ray.dir.z;
+			packet.active.v[i] = (i < count) ? -1 : 0;
+			hit.hitdist.v[i] = MAXDIST;
+			hit.normal.x.v[i] = 0.0f;
+			hit.normal.y.v[i] = 0.0f;
+			hit.normal.z.v[i] = 0.0f;
+			hit.materialID.v[i] = 0.0f;
+			hit.lightID.v[i] = -1.0f;
+		}
+	}
+
+	template<int N>
+	double PacketKernelThroughput(int kernel, const std::vector<Ray>& rays) {
+		// Same As KernelThroughput, Rays Are Packed Before Timing So Only Kernels Are Timed
+		std::vector<RayPacket<N>> packets((rays.size() + N - 1) / N);
+		std::vector<int> counts(packets.size());
+		HitPacket<N> missHit;
+		for (size_t i = 0; i < packets.size(); i++) {
+			counts[i] = (int)glm::min((size_t)N, rays.size() - i * N);
+			MakeRayPacket(&rays[i * N], counts[i], packets[i], missHit);
+		}
+
+		volatile float checksum = 0.0f;
+		uint64_t numRays = 0;
+		double seconds = 0.0;
+		auto start = std::chrono::steady_clock::now();
+		while (seconds < 0.25) {
+			float sum = 0.0f;
+			for (size_t i = 0; i < packets.size(); i++) {
+				HitPacket<N> hit = missHit;
+				PacketKernel(kernel, packets[i], hit);
+				for (int j = 0; j < counts[i]; j++) {
+					sum += hit.hitdist.v[j];
+				}
+			}
+			checksum = checksum + sum;
+			numRays += rays.size();
+			seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		return (double)numRays / seconds;
+	}
+
+	template<int N>
+	void ScenePacket(const glm::uvec2* xy, const glm::vec2* uv, int count, int k, glm::vec3* colors) {
+		// Camera Rays Of count Pixels Hit Analytic Objects As A Packet, Then Each Path Marches SDFs And Goes On Alone
+		uint32_t seeds[N];
+		Ray rays[N];
+		glm::vec4 l[N];
+		for (int i = 0; i < count; i++) {
+			seeds[i] = GenerateSeed(xy[i], k);
+			StartSampler(xy[i], k);
+			GenerateCameraRay(uv[i], seeds[i], rays[i], l[i]);
+		}
+		RayPacket<N> packet;
+		HitPacket<N> hit;
+		MakeRayPacket(rays, count, packet, hit);
+		PacketKernel(PACKET_KERNEL_ANALYTIC, packet, hit);
+		for (int i = 0; i < count; i++) {
+			AnalyticHit cameraHit = AnalyticHit{hit.hitdist.v[i], glm::vec3(hit.normal.x.v[i], hit.normal.y.v[i], hit.normal.z.v[i]), hit.materialID.v[i], hit.lightID.v[i]};
+			StartSampler(xy[i], k);
+			glm::vec4 radiance = TracePath(l[i], rays[i], seeds[i], &cameraHit);
+			colors[i] += SpectralRadianceToXYZ(l[i], radiance);
+		}
+	}
+
+	template<int N>
+	void RenderTilePackets(glm::ivec2 start, glm::ivec2 end, std::vector<glm::vec4>& texels, std::vector<gpuPixelStats>& stats) {
+		// Neighbouring Pixels Of A Row Share Packets, Rendering Then Ends As In Rendering
+		// Converged Pixels Are Left Out, So Packets Of Adaptive Sampling Are Filled With The Next Unconverged Pixels Of The Row
+		for (int y = start.y; y < end.y; y++) {
+			int x = start.x;
+			while (x < end.x) {
+				int count = 0;
+				int coords[N];
+				glm::uvec2 xy[N];
+				glm::vec2 uv[N];
+				glm::vec3 colors[N];
+				for (; (x < end.x) && (count < N); x++) {
+					coords[count] = x + pc.resolution.x * y;
+					if (pc.isAdaptive && !isPixelActive[coords[count]]) {
+						continue;
+					}
+					xy[count] = glm::uvec2(x, (uint32_t)pc.resolution.y - y);
+					uv[count] = (2.0f * glm::vec2(xy[count]) - glm::vec2(pc.resolution)) / (float)pc.resolution.y;
+					colors[count] = glm::vec3(0.0f);
+					count++;
+				}
+				if (count == 0) {
+					continue;
+				}
+				for (int k = 0; k < pc.samplesPerFrame; k++) {
+					ScenePacket<N>(xy, uv, count, k, colors);
+				}
+				for (int i = 0; i < count; i++) {
+					glm::vec3 outColor = colors[i] / (float)pc.samplesPerFrame;
+					outColor *= pc.apertureSize * pc.apertureSize * (float)pc.ISO;
+					Accumulate(glm::vec3(texels[coords[i]]), outColor, stats[coords[i]]);
+					texels[coords[i]] = glm::vec4(outColor, 1.0f);
+				}
+			}
+		}
+	}
+#endif
+
+	bool ObjectOcclusion(const Ray& ray, int type, int index, float maxDist) {
+		float hitdist = maxDist;
+		glm::vec3 normal = glm::vec3(0.0f);
+		float materialID = 0.0f;
+		float lightID = -1.0f;
+		return ObjectIntersection(ray, type, index, hitdist, normal, materialID, lightID);
+	}
+
+	bool BVHOcclusion(const Ray& ray, float maxDist, int ignoreObjectID) {
+		glm::vec3 invdir = 1.0f / ray.dir;
+		int stack[BVH_STACK_SIZE];
+		int stackSize = 1;
+		stack[0] = 0;
+
+		while (stackSize > 0) {
+			stackSize--;
+			const bvhNode& node = scene.bvhNodes[stack[stackSize]];
+			glm::vec2 tNode = RayIntersectNode(ray.origin, invdir, node);
+			if ((tNode.x > tNode.y) || (tNode.y < 0.0f) || (tNode.x > maxDist)) {
+				continue;
+			}
+
+			if (node.count > 0) {
+				for (int i = 0; i < node.count; i++) {
+					glm::ivec2 primitive = scene.bvhPrimitives[node.leftFirst + i];
+					if ((ObjectIDOffset(primitive.x) + primitive.y) == ignoreObjectID) {
+						continue;
+					}
+					if (ObjectOcclusion(ray, primitive.x, primitive.y, maxDist)) {
+						return true;
+					}
+				}
+				continue;
+			}
+
+			stack[stackSize] = node.leftFirst + 1;
+			stackSize++;
+			stack[stackSize] = node.leftFirst;
+			stackSize++;
+		}
+
+		return false;
+	}
+
+	bool Occlusion(const Ray& ray, float maxDist, int ignoreObjectID, const rayFootprint& footprint) {
+		for (int type = 0; type < 5; type++) {
+			if ((type != 1) && (scene.ubo.numObjects[7] > 0)) {
+				continue;
+			}
+			int objectOffset = ObjectIDOffset(type);
+			for (int i = 0; i < scene.ubo.numObjects[type]; i++) {
+				if ((i + objectOffset) == ignoreObjectID) {
+					continue;
+				}
+				if (ObjectOcclusion(ray, type, i, maxDist)) {
+					return true;
+				}
+			}
+		}
+
+		if (scene.ubo.numObjects[7] > 0) {
+			if (BVHOcclusion(ray, maxDist, ignoreObjectID)) {
+				return true;
+			}
+		} else {
+			for (int i = 0; i < scene.ubo.numPolynomials; i++) {
+				if (ObjectOcclusion(ray, 6, i, maxDist)) {
+					return true;
+				}
+			}
+			int rectOffset = ObjectIDOffset(7);
+			for (int i = 0; i < scene.ubo.numRects; i++) {
+				if ((i + rectOffset) == ignoreObjectID) {
+					continue;
+				}
+				if (ObjectOcclusion(ray, 7, i, maxDist)) {
+					return true;
+				}
+			}
+		}
+
+		for (int i = 0; i < scene.ubo.numHeightfields; i++) {
+			float hitdist = maxDist;
+			glm::vec3 normal = glm::vec3(0.0f);
+			float materialID = 0.0f;
+			float lightID = -1.0f;
+			if (HeightfieldIntersection(ray, scene.heightfields[i], hitdist, normal, materialID, lightID)) {
+				return true;
+			}
+		}
+
+		float t = 0.0f;
+		int sdfID = 0;
+		return SphereMarch(ray, maxDist, 0.0f, footprint, t, sdfID);
+	}
+
+	static void PCG32(uint32_t& seed) {
+		uint32_t state = seed * 747796405u + 2891336453u;
+		uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		seed = (word >> 22u) ^ word;
+	}
+
+	static float RandomFloatPCG32(uint32_t& seed) {
+		PCG32(seed);
+		return (float)seed / (float)0xFFFFFFFFu;
+	}
+
+	static uint32_t BitfieldReverse(uint32_t x) {
+		x = ((x >> 1u) & 0x55555555u) | ((x & 0x55555555u) << 1u);
+		x = ((x >> 2u) & 0x33333333u) | ((x & 0x33333333u) << 2u);
+		x = ((x >> 4u) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4u);
+		x = ((x >> 8u) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8u);
+		return (x >> 16u) | (x << 16u);
+	}
+
+	static uint32_t NestedUniformScramble(uint32_t x, uint32_t seed) {
+		x = BitfieldReverse(x);
+		x += seed;
+		x ^= x * 0x6c50b47cu;
+		x ^= x * 0xb82f1e52u;
+		x ^= x * 0xc7afe638u;
+		x ^= x * 0x8d22f6e6u;
+		return BitfieldReverse(x);
+	}
+
+	static uint32_t SobolSecondDimension(uint32_t index) {
+		uint32_t result = 0u;
+		for (uint32_t v = 1u << 31u; index != 0u; index >>= 1u, v ^= v >> 1u) {
+			if ((index & 1u) != 0u) {
+				result ^= v;
+			}
+		}
+		return result;
+	}
+
+	static float RandomFloatSobol(int dimension, uint32_t scramble) {
+		uint32_t seed = scramble ^ ((uint32_t)(dimension >> 1) * 0x9e3779b9u);
+		PCG32(seed);
+		uint32_t index = NestedUniformScramble(samplerIndex, seed);
+		uint32_t x = ((dimension & 1) == 0) ? BitfieldReverse(index) : SobolSecondDimension(index);
+		seed += (uint32_t)(dimension & 1) + 1u;
+		PCG32(seed);
+		return (float)(NestedUniformScramble(x, seed) >> 8u) / 16777216.0f;
+	}
+
+	float RandomFloatBlueNoise(int dimension) {
+		glm::uvec2 offset = glm::uvec2(glm::fract(glm::vec2(0.7548776662f, 0.5698402910f) * (float)(dimension + 1)) * (float)BLUE_NOISE_SIZE);
+		glm::uvec2 cell = (samplerPixel + offset) % (uint32_t)BLUE_NOISE_SIZE;
+		return glm::fract(scene.blueNoise[cell.x + BLUE_NOISE_SIZE * cell.y] + RandomFloatSobol(dimension, 0u));
+	}
+
+	void StartSampler(glm::uvec2 xy, int k) {
+		samplerPixel = xy;
+		samplerIndex = (uint32_t)(pc.frame - pc.samplesPerFrame + k);
+		samplerScramble = xy.x + (uint32_t)pc.resolution.x * xy.y;
+		PCG32(samplerScramble);
+		samplerDimension = 0;
+	}
+
+	static void SetSamplerBounce(int path) {
+		samplerDimension = SAMPLE_DIM_CAMERA_COUNT + path * SAMPLE_DIM_BOUNCE_COUNT;
+	}
+
+	float RandomFloat(uint32_t& seed, int dimension) {
+		if ((pc.samplerType == SAMPLER_BLUE_NOISE) && (samplerDimension + dimension < BLUE_NOISE_DIMENSIONS)) {
+			return RandomFloatBlueNoise(samplerDimension + dimension);
+		}
+		if (pc.samplerType != SAMPLER_PCG32) {
+			return RandomFloatSobol(samplerDimension + dimension, samplerScramble);
+		}
+		return RandomFloatPCG32(seed);
+	}
+
+	// Random Numbers Are Drawn In Separate Statements, Order Of Arguments Isn't Fixed In C++
+	glm::vec2 RandomVec2(uint32_t& seed, int dimension) {
+		float randomX = RandomFloat(seed, dimension);
+		float randomY = RandomFloat(seed, dimension + 1);
+		return glm::vec2(randomX, randomY);
+	}
+
+	uint32_t GenerateSeed(glm::uvec2 xy, int k) {
+		uint32_t seed = (uint32_t)(pc.frame - pc.samplesPerFrame + k);
+		PCG32(seed);
+		seed += xy.x + (uint32_t)pc.resolution.x * xy.y;
+		return seed;
+	}
+
+	static glm::vec4 SampleWavelengths(float l_h) {
+		return 390.0f + glm::mod(l_h - 390.0f + 0.25f * glm::vec4(1.0f, 2.0f, 3.0f, 4.0f) * 330.0f, 330.0f);
+	}
+
+	static glm::vec2 SampleUniformUnitDisk(const glm::vec2& random) {
+		float phi = 2.0f * PI * random.y;
+		float d = glm::sqrt(random.x);
+		return d * glm::vec2(glm::cos(phi), glm::sin(phi));
+	}
+
+	static glm::vec3 SampleUniformUnitSphere(const glm::vec2& random) {
+		float phi = 2.0f * PI * random.y;
+		float sinTheta = 2.0f * random.x - 1.0f;
+		float cosTheta = glm::sqrt(-sinTheta * sinTheta + 1.0f);
+		return glm::vec3(glm::cos(phi) * cosTheta, glm::sin(phi) * cosTheta, sinTheta);
+	}
+
+	static glm::vec3 SampleCosineUnitCone(const glm::vec2& random, float cosThetaMax) {
+		float cosAlphaMax = 2.0f * cosThetaMax * cosThetaMax - 1.0f;
+		float phi = 2.0f * PI * random.y;
+		float cosTheta = (1.0f - cosAlphaMax) * random.x + cosAlphaMax;
+		float sinTheta = glm::sqrt(-cosTheta * cosTheta + 1.0f);
+		return glm::normalize(glm::vec3(glm::cos(phi) * sinTheta, glm::sin(phi) * sinTheta, cosTheta + 1.0f));
+	}
+
+	static float CosineUnitConePDF(float cosTheta, float cosThetaMax) {
+		return cosTheta / (PI * (1.0f - cosThetaMax * cosThetaMax));
+	}
+
+	static glm::vec3 SampleUniformUnitCone(const glm::vec2& random, float oneMinusCosThetaMax) {
+		float oneMinusCosTheta = random.x * oneMinusCosThetaMax;
+		float sinTheta = glm::sqrt(glm::max(oneMinusCosTheta * (2.0f - oneMinusCosTheta), 0.0f));
+		float phi = 2.0f * PI * random.y;
+		return glm::vec3(glm::cos(phi) * sinTheta, glm::sin(phi) * sinTheta, 1.0f - oneMinusCosTheta);
+	}
+
+	static float UniformUnitConePDF(float oneMinusCosThetaMax) {
+		return 1.0f / (2.0f * PI * oneMinusCosThetaMax);
+	}
+
+	struct sphericalRectangle {
+		glm::vec3 x;
+		glm::vec3 y;
+		glm::vec3 z;
+		float x0;
+		float x1;
+		float y0;
+		float y1;
+		float z0;
+		float b0;
+		float b1;
+		float k;
+		float solidAngle;
+	};
+
+	static sphericalRectangle SphericalRectangle(const glm::vec3& corner, const glm::vec3& edgeX, const glm::vec3& edgeY, const glm::vec3& origin) {
+		sphericalRectangle rect{};
+		float lengthX = glm::length(edgeX);
+		float lengthY = glm::length(edgeY);
+		rect.x = edgeX / lengthX;
+		rect.y = edgeY / lengthY;
+		rect.z = glm::cross(rect.x, rect.y);
+		glm::vec3 d = corner - origin;
+		rect.x0 = glm::dot(d, rect.x);
+		rect.y0 = glm::dot(d, rect.y);
+		rect.z0 = glm::dot(d, rect.z);
+		if (rect.z0 > 0.0f) {
+			rect.z = -rect.z;
+			rect.z0 = -rect.z0;
+		}
+		rect.x1 = rect.x0 + lengthX;
+		rect.y1 = rect.y0 + lengthY;
+		rect.solidAngle = 0.0f;
+		if (rect.z0 == 0.0f) {
+			return rect;
+		}
+		glm::vec3 v00 = glm::vec3(rect.x0, rect.y0, rect.z0);
+		glm::vec3 v01 = glm::vec3(rect.x0, rect.y1, rect.z0);
+		glm::vec3 v10 = glm::vec3(rect.x1, rect.y0, rect.z0);
+		glm::vec3 v11 = glm::vec3(rect.x1, rect.y1, rect.z0);
+		glm::vec3 n0 = glm::normalize(glm::cross(v00, v10));
+		glm::vec3 n1 = glm::normalize(glm::cross(v10, v11));
+		glm::vec3 n2 = glm::normalize(glm::cross(v11, v01));
+		glm::vec3 n3 = glm::normalize(glm::cross(v01, v00));
+		float g0 = glm::acos(glm::clamp(-glm::dot(n0, n1), -1.0f, 1.0f));
+		float g1 = glm::acos(glm::clamp(-glm::dot(n1, n2), -1.0f, 1.0f));
+		float g2 = glm::acos(glm::clamp(-glm::dot(n2, n3), -1.0f, 1.0f));
+		float g3 = glm::acos(glm::clamp(-glm::dot(n3, n0), -1.0f, 1.0f));
+		rect.b0 = n0.z;
+		rect.b1 = n2.z;
+		rect.k = 2.0f * PI - g2 - g3;
+		rect.solidAngle = glm::max(g0 + g1 - rect.k, 0.0f);
+		return rect;
+	}
+
+	static glm::vec3 SampleSphericalRectangle(const sphericalRectangle& rect, const glm::vec2& random) {
+		float au = random.x * rect.solidAngle + rect.k;
+		float fu = (glm::cos(au) * rect.b0 - rect.b1) / glm::sin(au);
+		float cu = glm::clamp(((fu > 0.0f) ? 1.0f : -1.0f) / glm::sqrt(fu * fu + rect.b0 * rect.b0), -1.0f, 1.0f);
+		float xu = glm::clamp(-(cu * rect.z0) / glm::max(glm::sqrt(1.0f - cu * cu), 1e-7f), rect.x0, rect.x1);
+		float d = glm::sqrt(xu * xu + rect.z0 * rect.z0);
+		float h0 = rect.y0 / glm::sqrt(d * d + rect.y0 * rect.y0);
+		float h1 = rect.y1 / glm::sqrt(d * d + rect.y1 * rect.y1);
+		float hv = glm::mix(h0, h1, random.y);
+		float hv2 = hv * hv;
+		float yv = (hv2 < (1.0f - 1e-6f)) ? ((hv * d) / glm::sqrt(1.0f - hv2)) : rect.y1;
+		return glm::normalize(xu * rect.x + yv * rect.y + rect.z0 * rect.z);
+	}
+
+	static glm::vec4 SpectralPowerDistribution(const glm::vec4& l, float l_peak, float d, int invert) {
+		glm::vec4 x = (l - l_peak) / (2.0f * d * d);
+		glm::vec4 radiance = glm::exp(-x * x);
+		return glm::mix(radiance, 1.0f - radiance, (float)invert);
+	}
+
+	static glm::vec4 Emit(const glm::vec4& l, const gpuLight& lt) {
+		float temperature = glm::max(lt.emission.x, 0.0f);
+		glm::vec4 lm = l * 1e-9f;
+		glm::vec4 radiation = (1.1910429724e-16f * glm::pow(lm, glm::vec4(-5.0f))) / (glm::exp(0.014387768775f / (lm * temperature)) - 1.0f);
+		return (radiation / (4.0956746759e-6f * glm::pow(temperature, 5.0f))) * glm::max(lt.emission.y, 0.0f);
+	}
+
+	static float RefractiveIndexBK7Glass(float l) {
+		l *= 1e-3f;
+		float l2 = l * l;
+		float n2 = 1.0f;
+		n2 += (1.03961212f * l2) / (l2 - 6.00069867e-3f);
+		n2 += (0.231792344f * l2) / (l2 - 2.00179144e-2f);
+		n2 += (1.01046945f * l2) / (l2 - 1.03560653e2f);
+		return glm::sqrt(n2);
+	}
+
+	static glm::vec4 EvaluateBRDF(const glm::vec4& l, const gpuMaterial& mat) {
+		return SpectralPowerDistribution(l, mat.reflection.x, mat.reflection.y, (int)mat.reflection.z) / PI;
+	}
+
+	static glm::vec3 ToWorld(const glm::vec3& v, const glm::vec3& n) {
+		// Same Orthonormal Basis As OrthonormalBasis In Shader
+		glm::vec3 s = glm::vec3(0.0f, -1.0f, 0.0f);
+		glm::vec3 t = glm::vec3(-1.0f, 0.0f, 0.0f);
+		if (n.z >= -0.9999999f) {
+			float a = 1.0f / (1.0f + n.z);
+			float b = -n.x * n.y * a;
+			s = glm::vec3(1.0f - (n.x * n.x * a), b, -n.x);
+			t = glm::vec3(b, 1.0f - (n.y * n.y * a), -n.y);
+		}
+		return s * v.x + t * v.y + n * v.z;
+	}
+
+	bool LightSourceVisibilityCheck(const Ray& ray, int lightObjectID, const rayFootprint& footprint) {
+		int type = 0;
+		int index = 0;
+		ObjectFromID(lightObjectID, type, index);
+
+		float lightDist = MAXDIST;
+		glm::vec3 normal = glm::vec3(0.0f);
+		float materialID = 0.0f;
+		float lightID = -1.0f;
+		if (!ObjectIntersection(ray, type, index, lightDist, normal, materialID, lightID)) {
+			return false;
+		}
+
+		return !Occlusion(ray, lightDist, lightObjectID, footprint);
+	}
+
+	int LightSourceBounds(int light, float& boundingRadius, glm::vec3& pos, float& lightID) {
+		const int* numObjects = scene.ubo.numObjects;
+		int lightObjectID = Fetch(scene.lightIDs, light);
+
+		if (lightObjectID < numObjects[0]) {
+			gpuSphere object = Fetch(scene.spheres, lightObjectID);
+			boundingRadius = object.radius;
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+		lightObjectID -= numObjects[0];
+
+		if (lightObjectID < numObjects[1]) {
+			gpuPlane object = Fetch(scene.planes, lightObjectID);
+			boundingRadius = 1e5f;
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+		lightObjectID -= numObjects[1];
+
+		if (lightObjectID < numObjects[2]) {
+			gpuBox object = Fetch(scene.boxes, lightObjectID);
+			boundingRadius = glm::sqrt(object.boundingRadius2);
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+		lightObjectID -= numObjects[2];
+
+		if (lightObjectID < numObjects[3]) {
+			gpuLens object = Fetch(scene.lenses, lightObjectID);
+			boundingRadius = glm::sqrt(object.boundingRadius2);
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+		lightObjectID -= numObjects[3];
+
+		if (lightObjectID < numObjects[4]) {
+			gpuCyclide object = Fetch(scene.cyclides, lightObjectID);
+			boundingRadius = glm::sqrt(object.brad);
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+		lightObjectID -= numObjects[4] + scene.ubo.numPolynomials;
+
+		if (lightObjectID < scene.ubo.numRects) {
+			gpuRect object = Fetch(scene.rects, lightObjectID);
+			boundingRadius = glm::sqrt(object.boundingRadius2);
+			pos = object.pos;
+			lightID = (float)object.lightID;
+			return Fetch(scene.lightIDs, light);
+		}
+
+		return 0;
+	}
+
+	float LightNodeImportance(const gpuLightNode& node, const glm::vec3& pos, const glm::vec3& normal) {
+		glm::vec3 toNode = node.center - pos;
+		float dist2 = glm::dot(toNode, toNode);
+		float radius2 = node.radius * node.radius;
+		float cosine = 1.0f;
+		if (dist2 > radius2) {
+			float cosTheta = glm::dot(toNode, normal) / glm::sqrt(dist2);
+			float sinTheta = glm::sqrt(glm::max(1.0f - cosTheta * cosTheta, 0.0f));
+			float sinAlpha = node.radius / glm::sqrt(dist2);
+			float cosAlpha = glm::sqrt(1.0f - sinAlpha * sinAlpha);
+			cosine = (cosTheta >= cosAlpha) ? 1.0f : glm::max(cosTheta * cosAlpha + sinTheta * sinAlpha, 0.0f);
+		}
+		return node.power * cosine / glm::max(dist2, radius2);
+	}
+
+	float LightNodeProbabilityLeft(int index, const glm::vec3& pos, const glm::vec3& normal) {
+		int left = Fetch(scene.lightNodes, index).leftFirst;
+		float importanceLeft = LightNodeImportance(Fetch(scene.lightNodes, left), pos, normal);
+		float importanceRight = LightNodeImportance(Fetch(scene.lightNodes, left + 1), pos, normal);
+		float importance = importanceLeft + importanceRight;
+		return (importance > 0.0f) ? (importanceLeft / importance) : 0.5f;
+	}
+
+	int SampleLightBVH(float random, const glm::vec3& pos, const glm::vec3& normal, float& lightPMF) {
+		int index = 0;
+		lightPMF = 1.0f;
+		while (Fetch(scene.lightNodes, index).count == 0) {
+			int left = Fetch(scene.lightNodes, index).leftFirst;
+			float probabilityLeft = LightNodeProbabilityLeft(index, pos, normal);
+			if (random < probabilityLeft) {
+				index = left;
+				random = random / probabilityLeft;
+				lightPMF *= probabilityLeft;
+			} else {
+				index = left + 1;
+				random = (random - probabilityLeft) / (1.0f - probabilityLeft);
+				lightPMF *= 1.0f - probabilityLeft;
+			}
+			random = glm::min(random, 0.99999994f);
+		}
+		return Fetch(scene.lightNodes, index).leftFirst;
+	}
+
+	float LightBVHPMF(int index, const glm::vec3& pos, const glm::vec3& normal) {
+		float lightPMF = 1.0f;
+		int parent = Fetch(scene.lightNodes, index).parent;
+		while (parent >= 0) {
+			float probabilityLeft = LightNodeProbabilityLeft(parent, pos, normal);
+			lightPMF *= (index == Fetch(scene.lightNodes, parent).leftFirst) ? probabilityLeft : (1.0f - probabilityLeft);
+			index = parent;
+			parent = Fetch(scene.lightNodes, index).parent;
+		}
+		return lightPMF;
+	}
+
+	int SampleRandomLightSource(uint32_t& seed, const glm::vec3& origin, const glm::vec3& normal, float& boundingRadius, glm::vec3& pos, float& lightID, float& lightPMF) {
+		int light = SampleLightBVH(RandomFloat(seed, SAMPLE_DIM_LIGHT_CHOICE), origin, normal, lightPMF);
+		return LightSourceBounds(light, boundingRadius, pos, lightID);
+	}
+
+	static sphericalRectangle BoxFace(const gpuBox& object, const glm::vec3& localorigin, int axis) {
+		sphericalRectangle face{};
+		glm::vec3 halfSize = 0.5f * object.size;
+		glm::vec3 edgeX = glm::vec3(0.0f);
+		glm::vec3 edgeY = glm::vec3(0.0f);
+		edgeX[(axis + 1) % 3] = object.size[(axis + 1) % 3];
+		edgeY[(axis + 2) % 3] = object.size[(axis + 2) % 3];
+		if ((glm::abs(localorigin[axis]) > halfSize[axis]) && (edgeX[(axis + 1) % 3] > 0.0f) && (edgeY[(axis + 2) % 3] > 0.0f)) {
+			glm::vec3 corner = -halfSize;
+			corner[axis] = (localorigin[axis] > 0.0f) ? halfSize[axis] : -halfSize[axis];
+			face = SphericalRectangle(corner, edgeX, edgeY, localorigin);
+		}
+		return face;
+	}
+
+	static glm::vec3 SampleBoxDirection(const gpuBox& object, const glm::vec3& origin, glm::vec2 random, float& directionPDF) {
+		glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+		glm::vec3 localorigin = worldToLocal * (origin - object.pos);
+		if (glm::all(glm::lessThanEqual(glm::abs(localorigin), 0.5f * object.size))) {
+			directionPDF = 1.0f / (4.0f * PI);
+			return SampleUniformUnitSphere(random);
+		}
+		sphericalRectangle faces[3];
+		float solidAngle = 0.0f;
+		for (int axis = 0; axis < 3; axis++) {
+			faces[axis] = BoxFace(object, localorigin, axis);
+			solidAngle += faces[axis].solidAngle;
+		}
+		if (solidAngle <= 0.0f) {
+			directionPDF = 0.0f;
+			return glm::vec3(0.0f, 0.0f, 1.0f);
+		}
+		directionPDF = 1.0f / solidAngle;
+		float u = random.x * solidAngle;
+		int face = 0;
+		for (int axis = 0; axis < 3; axis++) {
+			if (faces[axis].solidAngle > 0.0f) {
+				face = axis;
+				if (u < faces[axis].solidAngle) {
+					break;
+				}
+				u -= faces[axis].solidAngle;
+			}
+		}
+		random.x = glm::clamp(u / faces[face].solidAngle, 0.0f, 1.0f);
+		return SampleSphericalRectangle(faces[face], random) * worldToLocal;
+	}
+
+	glm::vec3 SampleLightDirection(int lightObjectID, const glm::vec3& origin, const glm::vec3& lightPos, float boundingRadius, const glm::vec2& random, float& directionPDF) {
+		int type = 0;
+		int index = 0;
+		ObjectFromID(lightObjectID, type, index);
+		glm::vec3 toLight = lightPos - origin;
+		float dist2 = glm::dot(toLight, toLight);
+		directionPDF = 0.0f;
+
+		if (type == 0) {
+			float sin2ThetaMax = boundingRadius * boundingRadius / dist2;
+			float oneMinusCosThetaMax = (sin2ThetaMax < 1.0f) ? (sin2ThetaMax / (1.0f + glm::sqrt(1.0f - sin2ThetaMax))) : 2.0f;
+			directionPDF = UniformUnitConePDF(oneMinusCosThetaMax);
+			return ToWorld(SampleUniformUnitCone(random, oneMinusCosThetaMax), toLight / glm::sqrt(dist2));
+		}
+
+		if (type == 1) {
+			if (toLight.y == 0.0f) {
+				return glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+			glm::vec3 dir = SampleUniformUnitSphere(random);
+			directionPDF = 1.0f / (2.0f * PI);
+			return glm::vec3(dir.x, glm::abs(dir.z) * glm::sign(toLight.y), dir.y);
+		}
+
+		if (type == 2) {
+			return SampleBoxDirection(Fetch(scene.boxes, index), origin, random, directionPDF);
+		}
+
+		if (type == 7) {
+			gpuRect object = Fetch(scene.rects, index);
+			glm::mat3 worldToLocal = glm::mat3(object.worldToLocal);
+			if ((object.size.x <= 0.0f) || (object.size.y <= 0.0f)) {
+				return glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+			glm::vec3 localorigin = worldToLocal * (origin - object.pos);
+			glm::vec3 corner = glm::vec3(-0.5f * object.size.x, 0.0f, -0.5f * object.size.y);
+			sphericalRectangle sphericalRect = SphericalRectangle(corner, glm::vec3(object.size.x, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, object.size.y), localorigin);
+			if (sphericalRect.solidAngle <= 0.0f) {
+				return glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+			directionPDF = 1.0f / sphericalRect.solidAngle;
+			return SampleSphericalRectangle(sphericalRect, random) * worldToLocal;
+		}
+
+		float invLightDistance = 1.0f / glm::sqrt(dist2);
+		glm::vec3 lightDir = toLight * invLightDistance;
+		float sinthetaMax = glm::min(boundingRadius * invLightDistance, 1.0f);
+		float costhetaMax = glm::sqrt(1.0f - sinthetaMax * sinthetaMax);
+		glm::vec3 dir = ToWorld(SampleCosineUnitCone(random, costhetaMax), lightDir);
+		directionPDF = CosineUnitConePDF(glm::dot(dir, lightDir), costhetaMax);
+		return dir;
+	}
+
+	float LightShapeDirectionPDF(int lightObjectID, const glm::vec3& origin, const glm::vec3& lightPos, float boundingRadius, const glm::vec3& dir) {
+		int type = 0;
+		int index = 0;
+		ObjectFromID(lightObjectID, type, index);
+		glm::vec3 toLight = lightPos - origin;
+		float dist2 = glm::dot(toLight, toLight);
+
+		if (type == 0) {
+			float sin2ThetaMax = boundingRadius * boundingRadius / dist2;
+			float oneMinusCosThetaMax = (sin2ThetaMax < 1.0f) ? (sin2ThetaMax / (1.0f + glm::sqrt(1.0f - sin2ThetaMax))) : 2.0f;
+			return UniformUnitConePDF(oneMinusCosThetaMax);
+		}
+
+		if (type == 1) {
+			return (toLight.y * dir.y > 0.0f) ? (1.0f / (2.0f * PI)) : 0.0f;
+		}
+
+		if (type == 2) {
+			gpuBox object = Fetch(scene.boxes, index);
+			glm::vec3 localorigin = glm::mat3(object.worldToLocal) * (origin - object.pos);
+			if (glm::all(glm::lessThanEqual(glm::abs(localorigin), 0.5f * object.size))) {
+				return 1.0f / (4.0f * PI);
+			}
+			float solidAngle = 0.0f;
+			for (int axis = 0; axis < 3; axis++) {
+				solidAngle += BoxFace(object, localorigin, axis).solidAngle;
+			}
+			return (solidAngle > 0.0f) ? (1.0f / solidAngle) : 0.0f;
+		}
+
+		if (type == 7) {
+			gpuRect object = Fetch(scene.rects, index);
+			if ((object.size.x <= 0.0f) || (object.size.y <= 0.0f)) {
+				return 0.0f;
+			}
+			glm::vec3 localorigin = glm::mat3(object.worldToLocal) * (origin - object.pos);
+			glm::vec3 corner = glm::vec3(-0.5f * object.size.x, 0.0f, -0.5f * object.size.y);
+			float solidAngle = SphericalRectangle(corner, glm::vec3(object.size.x, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, object.size.y), localorigin).solidAngle;
+			return (solidAngle > 0.0f) ? (1.0f / solidAngle) : 0.0f;
+		}
+
+		float invLightDistance = 1.0f / glm::sqrt(dist2);
+		float sinthetaMax = glm::min(boundingRadius * invLightDistance, 1.0f);
+		float costhetaMax = glm::sqrt(1.0f - sinthetaMax * sinthetaMax);
+		return glm::max(CosineUnitConePDF(glm::dot(dir, toLight * invLightDistance), costhetaMax), 0.0f);
+	}
+
+	float LightDirectionPDF(int lightObjectID, const glm::vec3& origin, const glm::vec3& normal, const glm::vec3& dir) {
+		if ((lightObjectID < 0) || (scene.ubo.numObjects[6] == 0)) {
+			return 0.0f;
+		}
+		int leaf = Fetch(scene.lightIDs, scene.ubo.numObjects[6] + lightObjectID);
+		if (leaf < 0) {
+			return 0.0f;
+		}
+		float boundingRadius = 0.0f;
+		glm::vec3 lightPos = glm::vec3(0.0f);
+		float lightID = -1.0f;
+		LightSourceBounds(Fetch(scene.lightNodes, leaf).leftFirst, boundingRadius, lightPos, lightID);
+		return LightBVHPMF(leaf, origin, normal) * LightShapeDirectionPDF(lightObjectID, origin, lightPos, boundingRadius, dir);
+	}
+
+	static float MISPowerHeuristicsBeta2(float pdf1, float pdf2) {
+		return pdf1 * pdf1 / (pdf1 * pdf1 + pdf2 * pdf2);
+	}
+
+	static float LightSampleDeathProbability(float MISBRDFWeight) {
+		return 1.25f * glm::max(MISBRDFWeight - 0.2f, 0.0f);
+	}
+
+	float MISBRDFHitWeight(int hitObjectID, const Ray& inRay, const glm::vec3& BRDFNormal, float BRDFpdf) {
+		if (BRDFpdf <= 0.0f) {
+			return 1.0f;
+		}
+		float MISBRDFWeight = MISPowerHeuristicsBeta2(BRDFpdf, LightDirectionPDF(hitObjectID, inRay.origin, BRDFNormal, inRay.dir));
+		return MISBRDFWeight + LightSampleDeathProbability(MISBRDFWeight) * (1.0f - MISBRDFWeight);
+	}
+
+	bool SampleLightSource(const glm::vec4& l, glm::vec4 rayradiance, Ray& lightRay, const glm::vec3& normal, const gpuMaterial& mat, uint32_t& seed, int& lightObjectID, glm::vec4& shadowRadiance) {
+		float boundingRadius = 0.0f;
+		glm::vec3 lightPos = glm::vec3(0.0f);
+		float lightIDOut = -1.0f;
+		float lightpdf = 0.0f;
+		if (scene.ubo.numObjects[6] > 0) {
+			float lightPMF = 1.0f;
+			lightObjectID = SampleRandomLightSource(seed, lightRay.origin, normal, boundingRadius, lightPos, lightIDOut, lightPMF);
+			float directionPDF = 0.0f;
+			lightRay.dir = SampleLightDirection(lightObjectID, lightRay.origin, lightPos, boundingRadius, RandomVec2(seed, SAMPLE_DIM_LIGHT_DIRECTION), directionPDF);
+			if (directionPDF <= 0.0f) {
+				return false;
+			}
+			lightpdf = lightPMF * directionPDF;
+			float costheta = glm::dot(lightRay.dir, normal);
+			if (costheta >= 0.0f) {
+				float MISBRDFWeight = MISPowerHeuristicsBeta2(costheta / PI, lightpdf);
+				if (RandomFloat(seed, SAMPLE_DIM_LIGHT_ROULETTE) > LightSampleDeathProbability(MISBRDFWeight)) {
+					gpuLight lt = GetLightMix(lightIDOut);
+					rayradiance *= EvaluateBRDF(l, mat) * costheta / lightpdf;
+					shadowRadiance = Emit(l, lt) * rayradiance * (1.0f - MISBRDFWeight);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	glm::vec4 ShadeHit(const glm::vec4& l, glm::vec4& rayradiance, Ray& inRay, uint32_t& seed, float& BRDFpdf, glm::vec3& BRDFNormal, bool& isTerminate, float hitdist, const glm::vec3& normal, float materialID, float lightID, int hitObjectID, Ray& shadowRay, int& lightObjectID, glm::vec4& shadowRadiance) {
+		glm::vec4 radiance = glm::vec4(0.0f);
+		gpuMaterial mat = GetMaterialMix(materialID);
+		gpuLight lt = GetLightMix(lightID);
+		Ray outRay = inRay;
+		if (hitdist < MAXDIST) {
+			if (lt.emission.y > 0.0f) {
+				radiance = Emit(l, lt) * rayradiance * MISBRDFHitWeight(hitObjectID, inRay, BRDFNormal, BRDFpdf);
+				isTerminate = true;
+				return radiance;
+			}
+			outRay.origin = inRay.dir * hitdist + inRay.origin;
+			outRay.dir = glm::normalize(normal + SampleUniformUnitSphere(RandomVec2(seed, SAMPLE_DIM_BRDF)));
+			BRDFpdf = glm::dot(outRay.dir, normal) / PI;
+			BRDFNormal = normal;
+			shadowRay = outRay;
+			if (!SampleLightSource(l, rayradiance, shadowRay, normal, mat, seed, lightObjectID, shadowRadiance)) {
+				lightObjectID = -1;
+			}
+			float costheta = glm::dot(outRay.dir, normal);
+			rayradiance *= EvaluateBRDF(l, mat) * costheta / BRDFpdf;
+			float rayProbability = glm::clamp(glm::max(rayradiance.x, glm::max(rayradiance.y, glm::max(rayradiance.z, rayradiance.w))), 0.0f, 0.99f);
+			if (RandomFloat(seed, SAMPLE_DIM_ROULETTE) > rayProbability) {
+				isTerminate = true;
+				return radiance;
+			}
+			rayradiance *= 1.0f / rayProbability;
+			inRay = outRay;
+		} else {
+			isTerminate = true;
+		}
+		return radiance;
+	}
+
+	glm::vec4 TraceRay(const glm::vec4& l, glm::vec4& rayradiance, Ray& inRay, uint32_t& seed, int path, float& BRDFpdf, glm::vec3& BRDFNormal, bool& isTerminate, const AnalyticHit* analyticHit) {
+		glm::vec3 normal = glm::vec3(0.0f);
+		float materialID = 0.0f;
+		float lightID = -1.0f;
+		// Camera Rays Aren't BRDF Samples, So Their Packet Hits Don't Need Object IDs
+		int hitObjectID = -1;
+		float hitdist = MAXDIST;
+		// No Cone Pre-Pass On CPU, Camera Rays Are Marched From Their Origin
+		if (analyticHit != nullptr) {
+			hitdist = analyticHit->hitdist;
+			normal = analyticHit->normal;
+			materialID = analyticHit->materialID;
+			lightID = analyticHit->lightID;
+			SphereTracing(inRay, 0.0f, RayFootprint(path), hitdist, normal, materialID, lightID);
+		} else {
+			hitdist = Intersection(inRay, 0.0f, RayFootprint(path), normal, materialID, lightID, hitObjectID);
+		}
+		Ray shadowRay = inRay;
+		int lightObjectID = -1;
+		glm::vec4 shadowRadiance = glm::vec4(0.0f);
+		SetSamplerBounce(path);
+		glm::vec4 radiance = ShadeHit(l, rayradiance, inRay, seed, BRDFpdf, BRDFNormal, isTerminate, hitdist, normal, materialID, lightID, hitObjectID, shadowRay, lightObjectID, shadowRadiance);
+		if ((lightObjectID >= 0) && LightSourceVisibilityCheck(shadowRay, lightObjectID, RayFootprint(path + 1))) {
+			radiance += shadowRadiance;
+		}
+		return radiance;
+	}
+
+	glm::vec4 TracePath(const glm::vec4& l, Ray ray, uint32_t& seed, const AnalyticHit* cameraHit = nullptr) {
+		glm::vec4 radiance = glm::vec4(0.0f);
+		glm::vec4 rayradiance = glm::vec4(1.0f);
+		float BRDFpdf = 0.0f;
+		glm::vec3 BRDFNormal = glm::vec3(0.0f);
+		bool isTerminate = false;
+		for (int i = 0; i < pc.pathLength; i++) {
+			radiance += TraceRay(l, rayradiance, ray, seed, i, BRDFpdf, BRDFNormal, isTerminate, (i == 0) ? cameraHit : nullptr);
+			if (isTerminate) {
+				break;
+			}
+		}
+		return radiance;
+	}
+
+	void TracePathLens(float l, Ray& ray, const glm::vec3& forwardDir) {
+		gpuLens object{};
+		SetupLens(object, pc.lensRadius, pc.lensFocalLength, pc.lensThickness, true);
+		object.pos = cameraPos + forwardDir * pc.lensDistance;
+		object.worldToLocal = glm::mat3x4(glm::transpose(RotationMatrix(glm::vec3(0.0f, 90.0f - pc.cameraAngle.y, pc.cameraAngle.x))));
+		object.materialID = 0;
+		for (int i = 0; i < 2; i++) {
+			float hitdist = 1e6f;
+			glm::vec3 normal = glm::vec3(0.0f);
+			int isOutside = 1;
+			float materialID = 0.0f;
+			float lightID = -1.0f;
+			LensIntersection(ray, object, hitdist, normal, isOutside, materialID, lightID);
+			float n1 = (isOutside == 1) ? 1.0f : RefractiveIndexBK7Glass(l);
+			float n2 = (isOutside == 1) ? RefractiveIndexBK7Glass(l) : 1.0f;
+			float n12 = n1 / n2;
+			l = l * n12;
+			ray.origin = ray.dir * hitdist + ray.origin;
+			ray.dir = glm::refract(ray.dir, normal, n12);
+		}
+	}
+
+	void GenerateCameraRay(glm::vec2 uv, uint32_t& seed, Ray& ray, glm::vec4& l) {
+		uv += (2.0f * RandomVec2(seed, SAMPLE_DIM_PIXEL) - 0.5f) / glm::vec2(pc.resolution);
+
+		glm::mat3 matrix = RotationMatrix(glm::vec3(pc.cameraAngle, 0.0f));
+		uv *= -pc.cameraSize * 0.5f;
+		ray.origin = cameraPos + (glm::vec3(uv, 0.0f) * matrix);
+		glm::vec3 pointOnAperture = cameraPos + (glm::vec3(0.5f * pc.apertureSize * SampleUniformUnitDisk(RandomVec2(seed, SAMPLE_DIM_APERTURE)), pc.apertureDist) * matrix);
+		ray.dir = glm::normalize(pointOnAperture - ray.origin);
+		glm::vec3 forwardDir = glm::vec3(matrix[0][2], matrix[1][2], matrix[2][2]);
+
+		float l_h = glm::mix(360.0f, 800.0f, RandomFloat(seed, SAMPLE_DIM_WAVELENGTH));
+		TracePathLens(l_h, ray, forwardDir);
+		l = SampleWavelengths(l_h);
+	}
+
+	glm::vec3 SpectralRadianceToXYZ(const glm::vec4& l, const glm::vec4& radiance) {
+		glm::vec3 color = (radiance.x * WaveToXYZ(l.x) + radiance.y * WaveToXYZ(l.y) + radiance.z * WaveToXYZ(l.z) + radiance.w * WaveToXYZ(l.w)) * (720.0f - 390.0f) * 0.25f;
+		if (glm::any(glm::isnan(color))) {
+			return glm::vec3(0.0f);
+		}
+		return color;
+	}
+
+	glm::vec3 Scene(glm::uvec2 xy, glm::vec2 uv, int k) {
+		uint32_t seed = GenerateSeed(xy, k);
+		StartSampler(xy, k);
+		Ray ray;
+		glm::vec4 l;
+		GenerateCameraRay(uv, seed, ray, l);
+		glm::vec4 radiance = TracePath(l, ray, seed);
+		return SpectralRadianceToXYZ(l, radiance);
+	}
+
+	void Accumulate(const glm::vec3& inColor, glm::vec3& outColor, gpuPixelStats& stats) {
+		int frames = pc.currentSamples / pc.samplesPerFrame;
+		if (pc.adaptiveThreshold > 0.0f) {
+			frames = (pc.currentSamples == pc.samplesPerFrame) ? 1 : (stats.frames + 1);
+			glm::vec3 mean = (frames == 1) ? glm::vec3(0.0f) : stats.mean;
+			glm::vec3 m2 = (frames == 1) ? glm::vec3(0.0f) : stats.m2;
+			glm::vec3 delta = outColor - mean;
+			mean += delta / (float)frames;
+			m2 += delta * (outColor - mean);
+			stats.mean = mean;
+			stats.m2 = m2;
+			stats.frames = frames;
+		}
+
+		if ((pc.currentSamples == pc.samplesPerFrame) && (pc.frame > pc.samplesPerFrame)) {
+			float weight = glm::pow(2.0f, -8.0f / (pc.FPS * pc.persistence));
+			outColor = ((1.0f - weight) * outColor) + (weight * inColor);
+		} else {
+			outColor = ((float)(frames - 1) * inColor + outColor) / (float)frames;
+		}
+	}
+
+	glm::vec3 Rendering(glm::uvec2 invocation, const glm::vec3& inColor, gpuPixelStats& stats) {
+		glm::uvec2 xy = glm::uvec2(invocation.x, (uint32_t)pc.resolution.y - invocation.y);
+		glm::vec2 uv = (2.0f * glm::vec2(xy) - glm::vec2(pc.resolution)) / (float)pc.resolution.y;
+
+		glm::vec3 outColor = glm::vec3(0.0f);
+		for (int i = 0; i < pc.samplesPerFrame; i++) {
+			outColor += Scene(xy, uv, i);
+		}
+		outColor /= (float)pc.samplesPerFrame;
+		outColor *= pc.apertureSize * pc.apertureSize * (float)pc.ISO;
+		Accumulate(inColor, outColor, stats);
+
+		return outColor;
+	}
+};
+
+class App {
+public:
+    void run() {
+		if (CPURENDER) {
+			CPUMainLoop();
+			return;
+		}
+        InitWindow();
+		glslang::InitializeProcess();
+        InitVulkan();
+		if (!OFFSCREENRENDER) {
+			InitImGui();
+		}
+        MainLoop();
+		glslang::FinalizeProcess();
+        CleanUp();
+    }
+private:
+    GLFWwindow* window;
+	int W = WIDTH;
+	int H = HEIGHT;
+	bool VSync = false;
+
+	VkInstance instance;
+	VkDebugUtilsMessengerEXT debugMessenger;
+	VkSurfaceKHR surface;
+
+	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+	VkDevice device;
+
+	VkQueue graphicsQueue;
+	VkQueue computeQueue;
+	VkQueue presentQueue;
+
+	VkSwapchainKHR swapChain;
+	std::vector<VkImage> swapChainImages;
+	VkFormat swapChainImageFormat;
+	std::vector<VkImageView> swapChainImageViews;
+
+	VkRenderPass renderPass;
+
+	VkDescriptorSetLayout descriptorSetLayout;
+	std::vector<VkShaderModule> shaderModules;
+
+	VkPipelineLayout graphicsPipelineLayout;
+	VkPipeline graphicsPipeline;
+
+	VkPipelineLayout computePipelineLayout;
+	std::array<VkPipeline, KERNEL_STAGES_COUNT> computePipelines;
+	// SDF Functions Compiled Into The Compute Pipelines And The Build Of Pipelines Running In Background
+	std::vector<std::string> pipelineFunctions;
+	std::future<ComputePipelineBuild> pipelineBuild;
+	// Failed Builds Keep The Previous Pipelines And Aren't Retried Until SDFs Change
+	bool isPipelineBuildFailed = false;
+	// Pipelines Holding Every SDF Leave The Bytecode Interpreter Out, SPIR-V Is Kept To Specialize It Back In When An SDF Is Missing
+	std::vector<uint32_t> pipelineSPIRV;
+	bool isPipelinesInterpreting = false;
+
+	// Bytecode Of SDFs Missing From Compute Pipelines, With Offsets Of SDF And SDFMATERIAL For Each GLSL
+	std::vector<glm::ivec4> sdfCode;
+
+	// Scene And Render Of CPU Renderer, Used Instead Of Buffers When CPURENDER Is Set
+	CPUScene cpuScene;
+	std::vector<glm::vec4> cpuTexels;
+	std::array<std::atomic<uint64_t>, MARCH_STATS_COUNT> cpuMarchStats{};
+	std::vector<gpuPixelStats> cpuPixelStats;
+	int numCPUThreads = 0;
+	int cpuPacketWidth = 1;
+	bool isPacketBenchmark = false;
+	std::map<std::string, glm::ivec2> sdfCodeOffsets;
+	std::map<std::string, sdfMetadata> sdfMetadatas;
+	std::vector<float> heightfieldData;
+	std::vector<glm::ivec3> heightfieldLayouts;
+	std::map<std::string, std::string> computeShaderDefines;
+
+	VkCommandPool commandPool;
+
+	VkBuffer vertexBuffer;
+	VkDeviceMemory vertexBufferMemory;
+	VkBuffer indexBuffer;
+	VkDeviceMemory indexBufferMemory;
+
+	std::vector<VkBuffer> uniformBuffers;
+	std::vector<VkDeviceMemory> uniformBuffersMemory;
+	std::vector<void*> uniformBuffersMapped;
+	UniformBufferObject ubo;
+
+	// Spheres, Planes, Boxes, Lenses, Cyclides, SDFs, Materials, Lights, Light IDs, BVH Nodes, BVH Primitives And SDF Bytecode For Every Frame
+	std::vector<std::array<StorageBuffer, SCENE_BUFFERS_COUNT>> sceneBuffers;
+	VkBuffer CIEXYZ1931Buffer;
+	VkDeviceMemory CIEXYZ1931BufferMemory;
+	VkBuffer blueNoiseBuffer;
+	VkDeviceMemory blueNoiseBufferMemory;
+
+	// Path States And Ray Queues Of Wavefront Mode, Shared By All Frames
+	VkBuffer pathStateBuffer;
+	VkDeviceMemory pathStateBufferMemory;
+	VkBuffer queueBuffer;
+	VkDeviceMemory queueBufferMemory;
+	int numWavefrontPaths = 0;
+
+	// Cones Of Camera Rays Of Every Tile, Shared By All Frames
+	VkBuffer coneTileBuffer;
+	VkDeviceMemory coneTileBufferMemory;
+	int numConeTiles = 0;
+
+	// Statistics Of Every Pixel And The List Of Unconverged Pixels Of Adaptive Sampling, Shared By All Frames
+	// Only The Header Of The List Is Copied To Host Visible Memory, Statistics Stay On Device
+	VkBuffer adaptiveBuffer;
+	VkDeviceMemory adaptiveBufferMemory;
+	StorageBuffer adaptiveHeaderBuffer;
+	int numAdaptivePixels = 0;
+	int adaptiveFrames = 0;
+
+	// Baked SDF Cells, Bricks And Brick Cells Shared By Every Frame, Kept At A Single Element While Nothing Is Baked
+	std::array<VkBuffer, SDF_BAKE_BUFFERS_COUNT - 1> bakeBuffers;
+	std::array<VkDeviceMemory, SDF_BAKE_BUFFERS_COUNT - 1> bakeBuffersMemory;
+	std::array<VkDeviceSize, SDF_BAKE_BUFFERS_COUNT - 1> bakeBuffersSize{};
+	StorageBuffer marchStatsBuffer;
+	float bakeTime = 0.0f;
+	int numBakeBricks = 0;
+
+	VkBuffer texelBuffer;
+	VkDeviceMemory texelBufferMemory;
+	VkFormat texelBufferFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+	VkBufferView texelBufferView;
+
+	std::vector<VkFramebuffer> framebuffers;
+
+	VkDescriptorPool descriptorPool;
+	std::vector<VkDescriptorSet> descriptorSets;
+
+	PushConstantValues pushConstant;
+
+	std::vector<VkCommandBuffer> graphicsCommandBuffers;
+	std::vector<VkCommandBuffer> computeCommandBuffers;
+
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkFence> inFlightFences;
+
+	std::vector<VkSemaphore> computeFinishedSemaphores;
+	std::vector<VkFence> computeInFlightFences;
+
+	// Two Timestamps Around The Compute Commands Of Every Frame
+	VkQueryPool timestampQueryPool = VK_NULL_HANDLE;
+	float timestampPeriod = 0.0f;
+	float computeTime = 0.0f;
+	double totalComputeTime = 0.0;
+	int timedFrames = 0;
+
+	VkDescriptorPool imguiDescriptorPool;
+	ImGuiIO* io;
+
+	bool isWindowMinimized = false;
+	bool isVSyncChanged = false;
+	bool isCameraLocked = false;
+	bool isReset = false;
+	bool isUpdateUBO = true;
+	bool isRecompile = false;
+	bool isSDFChanged = true;
+	bool isUseBVH = true;
+	bool isWavefront = false;
+	bool isRaySorting = true;
+	bool isBakeSDF = false;
+	bool isRebakeSDF = false;
+	bool isCountMarchSteps = false;
+	bool isConePrepass = true;
+	bool isShrinkSDFBoxes = false;
+	bool isFootprintMarching = true;
+	bool isCyclideIntervalTest = true;
+	int samplerType = SAMPLER_BLUE_NOISE;
+	bool isSamplerComparison = false;
+	bool isAdaptiveSampling = false;
+	float adaptiveThreshold = 0.01f;
+	float timeBudget = 0.0f;
+	bool isHeightfieldChanged = true;
+	float marchStepsBefore = -1.0f;
+	std::string marchStepsChange;
+	bool isDualSDFNormals = false;
+
+	uint32_t currentFrame = 0;
+	int samplesPerFrame = 1;
+	int frame = 0;
+	int currentSamples = 0;
+	int numSamples = 1000;
+	float frameTime = 0.0166f;
+	float minFrameTime = MINFRAMETIME;
+	int cameraShotIndex = 1;
+
+	float persistence = 0.0625f;
+	int pathLength = 5;
+	int tonemap = TONEMAP;
+
+
+	nlohmann::ordered_json scene;
+	bool isLoadScene = false;
+	bool isSaveScene = false;
+	bool isLoadSDF = false;
+	bool isSaveSDF = false;
 	bool isSaveRender = false;
 
 	Camera camera{};
@@ -1188,14 +6776,20 @@ private:
 	std::vector<box> boxes;
 	std::vector<lens> lenses;
 	std::vector<cyclide> cyclides;
+	std::vector<polynomial> polynomials;
+	std::vector<rect> rects;
 	std::vector<sdf> sdfs;
+	std::vector<heightfield> heightfields;
 	std::vector<material> materials;
 	std::vector<light> lights;
+	std::vector<bvhNode> bvhNodes;
+	std::vector<bvhPrimitive> bvhPrimitives;
 
 	bool isImGuiWindowFocused = false;
 	int shotSelection = 0;
 	int objectSelection = 0;
 	int sdfSelection = 0;
+	int heightfieldSelection = 0;
 	int materialSelection = 0;
 	int lightSelection = 0;
 
@@ -1511,6 +7105,12 @@ private:
 		UBOLayoutFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_UNIFORM_BUFFER_STANDARD_LAYOUT_FEATURES;
 		UBOLayoutFeatures.uniformBufferStandardLayout = VK_TRUE;
 
+		// Timestamp Queries Are Reset From Host Once, So Reading A Frame Not Yet Timed Isn't An Error
+		VkPhysicalDeviceHostQueryResetFeatures hostQueryResetFeatures{};
+		hostQueryResetFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
+		hostQueryResetFeatures.hostQueryReset = VK_TRUE;
+		UBOLayoutFeatures.pNext = &hostQueryResetFeatures;
+
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 		createInfo.pNext = &UBOLayoutFeatures;
@@ -1783,7 +7383,7 @@ private:
 	}
 
 	void CreateDescriptorSetLayout() {
-		std::array<VkDescriptorSetLayoutBinding, 2> layoutBinding{};
+		std::array<VkDescriptorSetLayoutBinding, SCENE_BUFFERS_COUNT + WAVEFRONT_BUFFERS_COUNT + SDF_BAKE_BUFFERS_COUNT + 6> layoutBinding{};
 		VkDescriptorSetLayoutCreateInfo layoutInfo{};
 
 		layoutBinding[0].binding = 0;
@@ -1798,6 +7398,15 @@ private:
 		layoutBinding[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 		layoutBinding[1].pImmutableSamplers = nullptr;
 
+		// Scene Storage Buffers Followed By CIEXYZ1931 Table, Wavefront Buffers, SDF Bake Buffers, Cone Tiles, Blue Noise And Pixel Statistics
+		for (uint32_t i = 2; i < layoutBinding.size(); i++) {
+			layoutBinding[i].binding = i;
+			layoutBinding[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			layoutBinding[i].descriptorCount = 1;
+			layoutBinding[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			layoutBinding[i].pImmutableSamplers = nullptr;
+		}
+
 		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		layoutInfo.bindingCount = static_cast<uint32_t>(layoutBinding.size());
 		layoutInfo.pBindings = layoutBinding.data();
@@ -1819,7 +7428,7 @@ private:
 		shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_3);
 		shader.setEnvTarget(glslang::EshTargetSpv, glslang::EShTargetSpv_1_6);
 
-		shader.parse(GetDefaultResources(), 100, false, EShMsgDefault);
+		bool isParsed = shader.parse(GetDefaultResources(), 100, false, EShMsgDefault);
 
 		std::string shaderLog;
 		shaderLog.append(shader.getInfoLog());
@@ -1837,6 +7446,9 @@ private:
 		} else {
 			std::cout << "Success" << std::endl;
 		}
+		if (!isParsed) {
+			return {};
+		}
 
 		glslang::TProgram program;
 		program.addShader(&shader);
@@ -2001,69 +7613,86 @@ private:
 		}
 	}
 
-	void InsertSDF() {
-		for (int i = (sdfs.size() - 1); i >= 0; i--) {
-			std::string sdf = sdfs[i].glsl;
+	std::vector<int> SDFFunctionIDs(std::vector<std::string>& functions) {
+		// SDFs With The Same GLSL Share One Function, So Instances Of An SDF Are Compiled Only Once
+		std::vector<int> functionIDs(sdfs.size());
+		for (int i = 0; i < sdfs.size(); i++) {
+			auto it = std::find(functions.begin(), functions.end(), sdfs[i].glsl);
+			functionIDs[i] = (int)(it - functions.begin());
+			if (it == functions.end()) {
+				functions.push_back(sdfs[i].glsl);
+			}
+		}
+		return functionIDs;
+	}
+
+	void InsertSDF(std::string& code, const std::vector<std::string>& functions, bool isDualSDF) {
+		std::set<std::string> swizzles;
+		for (int i = (functions.size() - 1); i >= 0; i--) {
+			std::string sdf = functions[i];
 			std::string SDFName = "SDF";
-			std::string SDFFunction = "\n    if ((set";
+			std::string SDFFunction = "\n    case ";
 			std::string SDFMATERIALFunction;
-			std::string SDFPos;
+			std::string SDFGRADIENTFunction;
 			std::string SDFNum = std::to_string(i + 1);
-			std::string SDFCode = std::to_string(int(pow(2, i % 32)));
 
 			SDFName.append(SDFNum);
 			sdf.replace(sdf.find("sdf"), 3, SDFName);
-			SDFName.append("MATERIAL");
-			sdf.replace(sdf.find("sdfmaterial"), 11, SDFName);
+			sdf.replace(sdf.find("sdfmaterial"), 11, SDFName + "MATERIAL");
 			sdf.append("\n");
 
-			SDFPos.append("(p - vec3(sdfs[");
-			SDFPos.append(std::to_string(6 * i));
-			SDFPos.append("], sdfs[");
-			SDFPos.append(std::to_string(6 * i + 1));
-			SDFPos.append("], sdfs[");
-			SDFPos.append(std::to_string(6 * i + 2));
-			SDFPos.append("]))");
-
-			SDFFunction.append(std::to_string(((i - (i % 32)) / 32) + 1));
-			SDFFunction.append(" & ");
-			SDFFunction.append(SDFCode);
-			SDFFunction.append(") == ");
-			SDFFunction.append(SDFCode);
-			SDFFunction.append(") sdf");
-			SDFMATERIALFunction = SDFFunction;
-			SDFFunction.append(" = min(sdf, SDF");
+			if (isDualSDF) {
+				// Dual Number Version Follows The Original SDF, So It Can Use Its Helper Functions, Constants And Macros
+				try {
+					sdf.append(DualSDFTranslator(sdf, swizzles).Translate(SDFName));
+					SDFGRADIENTFunction = "\n    case " + std::to_string(i) + ": return " + SDFName + "DUAL(q).g;";
+				} catch (const std::runtime_error& error) {
+					std::cout << "SDF " << SDFNum << " Uses Tetrahedral Normals: " << error.what() << std::endl;
+				}
+			}
+
+			SDFFunction.append(std::to_string(i));
+			SDFFunction.append(": return SDF");
 			SDFFunction.append(SDFNum);
-			SDFFunction.append(SDFPos);
-			SDFFunction.append(");");
+			SDFMATERIALFunction = SDFFunction;
+			SDFFunction.append("(p);");
 
-			SDFMATERIALFunction.append("material = minMaterial(sdf, SDF");
-			SDFMATERIALFunction.append(SDFNum);
-			SDFMATERIALFunction.append(SDFPos);
-			SDFMATERIALFunction.append(", sdfmaterial, SDF");
-			SDFMATERIALFunction.append(SDFNum);
-			SDFMATERIALFunction.append("MATERIAL");
-			SDFMATERIALFunction.append(SDFPos);
-			SDFMATERIALFunction.append(");");
+			SDFMATERIALFunction.append("MATERIAL(p);");
 
-			computeShaderCode.insert(computeShaderCode.find("// Put SDF Functions Here") + 26, SDFFunction);
-			computeShaderCode.insert(computeShaderCode.find("// Put SDFMATERIAL Functions Here") + 34, SDFFunction);
-			computeShaderCode.insert(computeShaderCode.find("// Put SDFMATERIAL Functions Here") + 34, SDFMATERIALFunction);
-			computeShaderCode.insert(computeShaderCode.find("// All SDF Are Inserted Here") + 31, sdf);
+			code.insert(code.find("// Put SDF Functions Here") + 26, SDFFunction);
+			code.insert(code.find("// Put SDFMATERIAL Functions Here") + 34, SDFMATERIALFunction);
+			code.insert(code.find("// Put SDFGRADIENT Functions Here") + 34, SDFGRADIENTFunction);
+			code.insert(code.find("// All SDF Are Inserted Here") + 31, sdf);
 		}
+		code.insert(code.find("// All SDF Are Inserted Here") + 31, DualSDFTranslator::SwizzleFunctions(swizzles));
 	}
 
-	void CreateComputePipeline() {
+	void ReadComputeShader() {
 		computeShaderCode = ReadFile("../src/shader.comp");
 		if (isRunFromExecutables) {
 		computeShaderCode = ReadFile("./src/shader.comp");
 		}
+		computeShaderDefines = GLSLTokenizer::FindDefines(computeShaderCode);
+	}
 
-		InsertSDF();
-
-		VkPipelineShaderStageCreateInfo computeShaderStage{};
-		computeShaderStage = CreateShaderStageInfo(CreateShaderModule(GLSLToSPIRV(computeShaderCode, EShLangCompute)), VK_SHADER_STAGE_COMPUTE_BIT, "main");
+	std::vector<uint32_t> CompileComputeShader(std::string code, const std::vector<std::string>& functions, bool isDualSDF) {
+		std::string shaderCode = code;
+		InsertSDF(shaderCode, functions, isDualSDF);
+		std::vector<uint32_t> computeShaderSPIRV = GLSLToSPIRV(shaderCode, EShLangCompute);
+		if (computeShaderSPIRV.empty() && isDualSDF) {
+			// Rewritten SDFs Can Still Fail To Compile, Then Every SDF Falls Back To Tetrahedral Normals
+			std::cout << "Dual Number SDFs Failed To Compile, Using Tetrahedral Normals" << std::endl;
+			shaderCode = code;
+			InsertSDF(shaderCode, functions, false);
+			computeShaderSPIRV = GLSLToSPIRV(shaderCode, EShLangCompute);
+		}
+		if (computeShaderSPIRV.empty()) {
+			throw std::runtime_error("Failed To Compile Compute Shader!");
+		}
+		return computeShaderSPIRV;
+	}
 
+	void CreateComputePipelineLayout() {
 		VkPushConstantRange pushConstantRange{};
 		pushConstantRange.offset = 0;
 		pushConstantRange.size = sizeof(PushConstantValues);
@@ -2080,17 +7709,72 @@ private:
 		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS) {
 			throw std::runtime_error("Failed To Create Compute Pipeline Layout!");
 		}
+	}
 
-		VkComputePipelineCreateInfo pipelineInfo{};
-		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-		pipelineInfo.layout = computePipelineLayout;
-		pipelineInfo.stage = computeShaderStage;
+	std::array<VkPipeline, KERNEL_STAGES_COUNT> CreateComputePipelines(const std::vector<uint32_t>& computeShaderSPIRV, bool isSDFInterpreter) {
+		// Module Is Only Needed While Creating Pipelines, So It Stays Local And Pipelines Can Be Built On Another Thread
+		VkShaderModule computeShaderModule = CreateShaderModule(computeShaderSPIRV);
+
+		VkPipelineShaderStageCreateInfo computeShaderStage{};
+		computeShaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		computeShaderStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		computeShaderStage.module = computeShaderModule;
+		computeShaderStage.pName = "main";
+
+		// Every Kernel Stage Is A Pipeline Of The Same Shader With Its Own kernelStage Specialization Constant
+		// All Of Them Share isSDFInterpreter, Which Leaves The Bytecode Interpreter Out When Off
+		std::array<VkSpecializationMapEntry, 2> specializationEntries{};
+		specializationEntries[0].constantID = 0;
+		specializationEntries[0].offset = 0;
+		specializationEntries[0].size = sizeof(int);
+		specializationEntries[1].constantID = 1;
+		specializationEntries[1].offset = sizeof(int);
+		specializationEntries[1].size = sizeof(VkBool32);
+
+		std::array<std::array<uint32_t, 2>, KERNEL_STAGES_COUNT> specializationData{};
+		std::array<VkSpecializationInfo, KERNEL_STAGES_COUNT> specializationInfo{};
+		std::array<VkComputePipelineCreateInfo, KERNEL_STAGES_COUNT> pipelineInfo{};
+		for (int i = 0; i < KERNEL_STAGES_COUNT; i++) {
+			specializationData[i] = { static_cast<uint32_t>(i), isSDFInterpreter ? VK_TRUE : VK_FALSE };
+
+			specializationInfo[i].mapEntryCount = static_cast<uint32_t>(specializationEntries.size());
+			specializationInfo[i].pMapEntries = specializationEntries.data();
+			specializationInfo[i].dataSize = sizeof(specializationData[i]);
+			specializationInfo[i].pData = specializationData[i].data();
+
+			pipelineInfo[i].sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			pipelineInfo[i].layout = computePipelineLayout;
+			pipelineInfo[i].stage = computeShaderStage;
+			pipelineInfo[i].stage.pSpecializationInfo = &specializationInfo[i];
+		}
+
+		std::array<VkPipeline, KERNEL_STAGES_COUNT> pipelines{};
+		VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, static_cast<uint32_t>(pipelineInfo.size()), pipelineInfo.data(), nullptr, pipelines.data());
+		vkDestroyShaderModule(device, computeShaderModule, nullptr);
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("Failed To Create Compute Pipelines!");
+		}
+
+		return pipelines;
+	}
 
-		if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
-			throw std::runtime_error("Failed To Create Compute Pipeline!");
+	void CleanUpComputePipelines(const std::array<VkPipeline, KERNEL_STAGES_COUNT>& pipelines) {
+		for (VkPipeline pipeline : pipelines) {
+			vkDestroyPipeline(device, pipeline, nullptr);
 		}
 	}
 
+	void CreateComputePipeline() {
+		ReadComputeShader();
+		CreateComputePipelineLayout();
+
+		pipelineFunctions.clear();
+		SDFFunctionIDs(pipelineFunctions);
+		pipelineSPIRV = CompileComputeShader(computeShaderCode, pipelineFunctions, isDualSDFNormals);
+		computePipelines = CreateComputePipelines(pipelineSPIRV, false);
+		isPipelinesInterpreting = false;
+	}
+
 	void CreateCommandPool() {
 		QueueFamilyIndices queueFamilyIndices = FindQueueFamilies(physicalDevice);
 
@@ -2179,6 +7863,37 @@ private:
 		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
 	}
 
+	void FillBuffer(VkBuffer dstBuffer, VkDeviceSize size, uint32_t data) {
+		VkCommandBufferAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocateInfo.commandPool = commandPool;
+		allocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+		vkCmdFillBuffer(commandBuffer, dstBuffer, 0, size, data);
+
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+
+		vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(graphicsQueue);
+
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	}
+
 	void CreateVertexBuffer() {
 		VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
 
@@ -2197,54 +7912,445 @@ private:
 		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 		vertexBuffer, vertexBufferMemory);
 
-		CopyBuffer(stagingBuffer, vertexBuffer, bufferSize);
+		CopyBuffer(stagingBuffer, vertexBuffer, bufferSize);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+	}
+
+	void CreateIndexBuffer() {
+		VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		stagingBuffer, stagingBufferMemory);
+
+		void* data;
+		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+		memcpy(data, indices.data(), (size_t)bufferSize);
+		vkUnmapMemory(device, stagingBufferMemory);
+
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+		VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		indexBuffer, indexBufferMemory);
+
+		CopyBuffer(stagingBuffer, indexBuffer, bufferSize);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+	}
+
+	void CreateUniformBuffer() {
+		VkDeviceSize bufferSize = sizeof(UniformBufferObject);
+
+		uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		uniformBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+		uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			CreateBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			uniformBuffers[i], uniformBuffersMemory[i]);
+
+			vkMapMemory(device, uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
+		}
+	}
+
+	void CreateStorageBuffer(StorageBuffer& storageBuffer, VkDeviceSize size, VkBufferUsageFlags usage = 0) {
+		CreateBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		storageBuffer.buffer, storageBuffer.memory);
+
+		vkMapMemory(device, storageBuffer.memory, 0, size, 0, &storageBuffer.mapped);
+		storageBuffer.size = size;
+	}
+
+	void CleanUpStorageBuffer(StorageBuffer& storageBuffer) {
+		vkDestroyBuffer(device, storageBuffer.buffer, nullptr);
+		vkFreeMemory(device, storageBuffer.memory, nullptr);
+		storageBuffer = StorageBuffer{};
+	}
+
+	void CreateSceneBuffers() {
+		// Scene Buffers Start Small And Grow When The Scene Doesn't Fit Anymore
+		sceneBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			for (size_t k = 0; k < SCENE_BUFFERS_COUNT; k++) {
+				CreateStorageBuffer(sceneBuffers[i][k], 256);
+			}
+		}
+	}
+
+	template<typename T>
+	bool UploadSceneBuffer(int index, const std::vector<T>& data) {
+		// Copies The Array To Scene Buffer Of Every Frame, Returns True If Buffers Had To Be Recreated
+		// Empty Arrays Still Keep A Buffer Since Zero Sized Buffers Aren't Allowed
+		VkDeviceSize size = std::max(sizeof(T) * data.size(), sizeof(T));
+		bool isRecreated = false;
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			StorageBuffer& storageBuffer = sceneBuffers[i][index];
+			if (size > storageBuffer.size) {
+				if (!isRecreated) {
+					vkDeviceWaitIdle(device);
+				}
+				VkDeviceSize newSize = std::max(size, 2 * storageBuffer.size);
+				CleanUpStorageBuffer(storageBuffer);
+				CreateStorageBuffer(storageBuffer, newSize);
+				isRecreated = true;
+			}
+			if (!data.empty()) {
+				memcpy(storageBuffer.mapped, data.data(), sizeof(T) * data.size());
+			}
+		}
+
+		return isRecreated;
+	}
+
+	void CreateCIEXYZ1931Buffer() {
+		// CIEXYZ1931 Table Never Changes, So It Is Uploaded Once To Device Local Memory
+		VkDeviceSize bufferSize = sizeof(CIEXYZ1931);
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		stagingBuffer, stagingBufferMemory);
+
+		void* data;
+		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+		memcpy(data, CIEXYZ1931, (size_t)bufferSize);
+		vkUnmapMemory(device, stagingBufferMemory);
+
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		CIEXYZ1931Buffer, CIEXYZ1931BufferMemory);
+
+		CopyBuffer(stagingBuffer, CIEXYZ1931Buffer, bufferSize);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+	}
+
+	void CreateBlueNoiseBuffer() {
+		// Blue Noise Tile Is Generated Once At Startup, Then Uploaded Like CIEXYZ1931 Table
+		std::vector<float> blueNoise = GenerateBlueNoise();
+		VkDeviceSize bufferSize = sizeof(float) * blueNoise.size();
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		stagingBuffer, stagingBufferMemory);
+
+		void* data;
+		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+		memcpy(data, blueNoise.data(), (size_t)bufferSize);
+		vkUnmapMemory(device, stagingBufferMemory);
+
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		blueNoiseBuffer, blueNoiseBufferMemory);
+
+		CopyBuffer(stagingBuffer, blueNoiseBuffer, bufferSize);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+	}
+
+	void CreateWavefrontBuffers(int numPaths) {
+		// One Path State Per Pixel, Queues Hold Path IDs Of Two Extension Ray Queues, The Shadow Ray Queue And The Sorted Queue
+		// Megakernel Still Needs Them Bound, So They Are Kept At A Single Path Then
+		CreateBuffer(sizeof(gpuPathState) * numPaths, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, pathStateBuffer, pathStateBufferMemory);
+
+		CreateBuffer(4 * sizeof(gpuQueueHeader) + 2 * sizeof(uint32_t) * SORT_BUCKETS_COUNT + 4 * sizeof(int) * numPaths, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+		VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, queueBuffer, queueBufferMemory);
+
+		numWavefrontPaths = numPaths;
+	}
+
+	void CleanUpWavefrontBuffers() {
+		vkDestroyBuffer(device, pathStateBuffer, nullptr);
+		vkFreeMemory(device, pathStateBufferMemory, nullptr);
+		vkDestroyBuffer(device, queueBuffer, nullptr);
+		vkFreeMemory(device, queueBufferMemory, nullptr);
+	}
+
+	void UpdateWavefrontBuffers() {
+		// Resizes Wavefront Buffers When The Mode Or The Resolution Changes
+		int numPaths = isWavefront ? W * H : 1;
+		if (numPaths == numWavefrontPaths) {
+			return;
+		}
+
+		vkDeviceWaitIdle(device);
+
+		CleanUpWavefrontBuffers();
+		CreateWavefrontBuffers(numPaths);
+
+		UpdateDescriptorSet();
+	}
+
+	int ConeTilesCount() {
+		return ((W + CONE_TILE_SIZE - 1) / CONE_TILE_SIZE) * ((H + CONE_TILE_SIZE - 1) / CONE_TILE_SIZE);
+	}
+
+	void CreateConeTileBuffer(int numTiles) {
+		CreateBuffer(sizeof(gpuConeTile) * numTiles, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, coneTileBuffer, coneTileBufferMemory);
+
+		numConeTiles = numTiles;
+	}
+
+	void CleanUpConeTileBuffer() {
+		vkDestroyBuffer(device, coneTileBuffer, nullptr);
+		vkFreeMemory(device, coneTileBufferMemory, nullptr);
+	}
+
+	void UpdateConeTileBuffer() {
+		// Resizes Cone Tiles When The Resolution Changes
+		int numTiles = ConeTilesCount();
+		if (numTiles == numConeTiles) {
+			return;
+		}
+
+		vkDeviceWaitIdle(device);
+
+		CleanUpConeTileBuffer();
+		CreateConeTileBuffer(numTiles);
+
+		UpdateDescriptorSet();
+	}
+
+	void CreateAdaptiveBuffer(int numPixels) {
+		// Header Of The List Of Unconverged Pixels Followed By Statistics Of Every Pixel, Host Reads A Copy Of The Header To Stop Offscreen Renders
+		// Statistics Start Without Any Frames, So Pixels Restart Their Accumulation After The Buffer Is Recreated
+		VkDeviceSize size = sizeof(gpuQueueHeader) + sizeof(gpuPixelStats) * numPixels;
+		CreateBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, adaptiveBuffer, adaptiveBufferMemory);
+		FillBuffer(adaptiveBuffer, size, 0);
+
+		CreateStorageBuffer(adaptiveHeaderBuffer, sizeof(gpuQueueHeader), VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+		memset(adaptiveHeaderBuffer.mapped, 0, sizeof(gpuQueueHeader));
+
+		numAdaptivePixels = numPixels;
+	}
+
+	void CleanUpAdaptiveBuffer() {
+		vkDestroyBuffer(device, adaptiveBuffer, nullptr);
+		vkFreeMemory(device, adaptiveBufferMemory, nullptr);
+		CleanUpStorageBuffer(adaptiveHeaderBuffer);
+	}
+
+	void UpdateAdaptiveBuffer() {
+		// Resizes Pixel Statistics When The Resolution Changes
+		if (W * H == numAdaptivePixels) {
+			return;
+		}
+
+		vkDeviceWaitIdle(device);
+
+		CleanUpAdaptiveBuffer();
+		CreateAdaptiveBuffer(W * H);
+
+		UpdateDescriptorSet();
+	}
+
+	int ActivePixelsCount() {
+		// Frames In Flight May Be Rebuilding The List Of Unconverged Pixels, So They Are Waited For Before The Copy Of Its Header Is Read
+		vkWaitForFences(device, static_cast<uint32_t>(computeInFlightFences.size()), computeInFlightFences.data(), VK_TRUE, UINT64_MAX);
+		return (int)((gpuQueueHeader*)adaptiveHeaderBuffer.mapped)->count;
+	}
+
+	std::vector<gpuPixelStats> ReadAdaptiveStats() {
+		// Copies Statistics Of Every Pixel Back Through A Staging Buffer, Only Done Once A Render Is Finished
+		VkDeviceSize bufferSize = sizeof(gpuQueueHeader) + sizeof(gpuPixelStats) * numAdaptivePixels;
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		stagingBuffer, stagingBufferMemory);
+
+		CopyBuffer(adaptiveBuffer, stagingBuffer, bufferSize);
+		std::vector<gpuPixelStats> stats(numAdaptivePixels);
+		void* mapped;
+		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &mapped);
+		memcpy(stats.data(), (char*)mapped + sizeof(gpuQueueHeader), sizeof(gpuPixelStats) * numAdaptivePixels);
+		vkUnmapMemory(device, stagingBufferMemory);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+		return stats;
+	}
+
+	void CreateSDFBakeBuffer(int index, VkDeviceSize size) {
+		CreateBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bakeBuffers[index], bakeBuffersMemory[index]);
+		bakeBuffersSize[index] = size;
+	}
+
+	void CleanUpSDFBakeBuffer(int index) {
+		vkDestroyBuffer(device, bakeBuffers[index], nullptr);
+		vkFreeMemory(device, bakeBuffersMemory[index], nullptr);
+		bakeBuffersSize[index] = 0;
+	}
+
+	void CreateSDFBakeBuffers() {
+		// Cells, Bricks And Brick Cells Start At A Single Element, March Statistics Are Read By Host Every Frame
+		CreateSDFBakeBuffer(0, sizeof(gpuBakeCell));
+		CreateSDFBakeBuffer(1, sizeof(float));
+		CreateSDFBakeBuffer(2, sizeof(int));
 
-		vkDestroyBuffer(device, stagingBuffer, nullptr);
-		vkFreeMemory(device, stagingBufferMemory, nullptr);
+		CreateStorageBuffer(marchStatsBuffer, sizeof(gpuMarchStats));
+		memset(marchStatsBuffer.mapped, 0, sizeof(gpuMarchStats));
 	}
 
-	void CreateIndexBuffer() {
-		VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
+	void CleanUpSDFBakeBuffers() {
+		for (int i = 0; i < bakeBuffers.size(); i++) {
+			CleanUpSDFBakeBuffer(i);
+		}
+		CleanUpStorageBuffer(marchStatsBuffer);
+	}
+
+	template<typename T>
+	void TransferSDFBakeBuffer(int index, std::vector<T>& data, bool isUpload) {
+		// Copies Between Device Local Bake Buffer And Host Through A Staging Buffer
+		VkDeviceSize bufferSize = sizeof(T) * data.size();
 
 		VkBuffer stagingBuffer;
 		VkDeviceMemory stagingBufferMemory;
-		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 		stagingBuffer, stagingBufferMemory);
 
-		void* data;
-		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, indices.data(), (size_t)bufferSize);
+		void* mapped;
+		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &mapped);
+		if (isUpload) {
+			memcpy(mapped, data.data(), (size_t)bufferSize);
+			CopyBuffer(stagingBuffer, bakeBuffers[index], bufferSize);
+		} else {
+			CopyBuffer(bakeBuffers[index], stagingBuffer, bufferSize);
+			memcpy(data.data(), mapped, (size_t)bufferSize);
+		}
 		vkUnmapMemory(device, stagingBufferMemory);
 
-		CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-		VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		indexBuffer, indexBufferMemory);
-
-		CopyBuffer(stagingBuffer, indexBuffer, bufferSize);
-
 		vkDestroyBuffer(device, stagingBuffer, nullptr);
 		vkFreeMemory(device, stagingBufferMemory, nullptr);
 	}
 
-	void CreateUniformBuffer() {
-		for (int i = 0; i < std::size(CIEXYZ1931); i++) {
-			ubo.CIEXYZ1931[i] = CIEXYZ1931[i];
+	void DispatchSDFBake(int stage, uint32_t numItems) {
+		// Bake Passes Run Once Outside Of Frames, Items Are Spread Over A 2D Grid Of Work Groups To Stay Within Dispatch Limits
+		uint32_t numGroups = (numItems + 255) / 256;
+		uint32_t groupsX = std::min(numGroups, 65535u);
+		uint32_t groupsY = (numGroups + groupsX - 1) / groupsX;
+
+		VkCommandBufferAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocateInfo.commandPool = commandPool;
+		allocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+		computePipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstant), &pushConstant);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[stage]);
+		vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+
+		vkQueueSubmit(computeQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(computeQueue);
+
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	}
+
+	void BakeSDFs() {
+		// Every SDF Gets A Grid Of Cells Holding The Distance At Their Centers, Cells The Surface Can Pass Through Also Get A Brick Of Samples
+		// SDFs Only Exist As GLSL, So Both Steps Are Compute Passes Of The Path Tracer Itself
+		isRebakeSDF = false;
+		bool isBaked = bakeBuffersSize[0] > sizeof(gpuBakeCell);
+		if (!isBakeSDF && !isBaked) {
+			return;
 		}
 
-		VkDeviceSize bufferSize = sizeof(UniformBufferObject);
+		vkDeviceWaitIdle(device);
+		CleanUpSDFBakeBuffer(0);
+		CleanUpSDFBakeBuffer(1);
+		CleanUpSDFBakeBuffer(2);
+		bakeTime = 0.0f;
+		numBakeBricks = 0;
+
+		if (!isBakeSDF || sdfs.empty()) {
+			CreateSDFBakeBuffer(0, sizeof(gpuBakeCell));
+			CreateSDFBakeBuffer(1, sizeof(float));
+			CreateSDFBakeBuffer(2, sizeof(int));
+			UpdateDescriptorSet();
+			return;
+		}
 
-		uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-		uniformBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
-		uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+		double startTime = glfwGetTime();
 
-		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-			CreateBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			uniformBuffers[i], uniformBuffersMemory[i]);
+		std::vector<gpuBakeCell> cells(sdfs.size() * SDF_BAKE_CELLS);
+		CreateSDFBakeBuffer(0, sizeof(gpuBakeCell) * cells.size());
+		CreateSDFBakeBuffer(1, sizeof(float));
+		CreateSDFBakeBuffer(2, sizeof(int));
+		UpdateDescriptorSet();
+		DispatchSDFBake(STAGE_BAKE_CELLS, static_cast<uint32_t>(cells.size()));
+		TransferSDFBakeBuffer(0, cells, false);
+
+		// Distance At Center Bounds Distance Anywhere In The Cell Up To Half Of Its Diagonal
+		// One Sample Spacing Is Added So Cells Without Brick Never Need Exact Evaluation
+		std::vector<int> brickCells;
+		for (int i = 0; i < cells.size(); i++) {
+			const sdf& object = sdfs[i / SDF_BAKE_CELLS];
+			if (SDFMetadata(object).isDistanceEstimator) {
+				continue;
+			}
+			float cellDiagonal = glm::length(glm::vec3(object.size[0], object.size[1], object.size[2])) / SDF_BAKE_GRID;
+			if (std::abs(cells[i].distance) <= (0.5f * cellDiagonal + cellDiagonal / (SDF_BRICK_SIZE - 1))) {
+				cells[i].brick = (int)brickCells.size();
+				brickCells.push_back(i);
+			}
+		}
+		numBakeBricks = (int)brickCells.size();
 
-			vkMapMemory(device, uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
+		TransferSDFBakeBuffer(0, cells, true);
+		if (numBakeBricks > 0) {
+			CleanUpSDFBakeBuffer(1);
+			CleanUpSDFBakeBuffer(2);
+			CreateSDFBakeBuffer(1, sizeof(float) * SDF_BRICK_SAMPLES * numBakeBricks);
+			CreateSDFBakeBuffer(2, sizeof(int) * numBakeBricks);
+			TransferSDFBakeBuffer(2, brickCells, true);
+			UpdateDescriptorSet();
+			DispatchSDFBake(STAGE_BAKE_BRICKS, static_cast<uint32_t>(SDF_BRICK_SAMPLES * numBakeBricks));
 		}
+
+		bakeTime = static_cast<float>(1000.0 * (glfwGetTime() - startTime));
+		printf("Baked %i SDFs: %0.3fms, %i Bricks, %0.3fMB \n", (int)sdfs.size(), bakeTime, numBakeBricks, SDFBakeMemory() / 1048576.0);
+	}
+
+	double SDFBakeMemory() {
+		return (double)(bakeBuffersSize[0] + bakeBuffersSize[1] + bakeBuffersSize[2]);
 	}
 
 	void CreateTexelBuffer() {
@@ -2292,7 +8398,7 @@ private:
 	}
 
 	void CreateDescriptorPool() {
-		std::array<VkDescriptorPoolSize, 2> poolSize{};
+		std::array<VkDescriptorPoolSize, 3> poolSize{};
 		VkDescriptorPoolCreateInfo poolInfo{};
 
 		poolSize[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -2301,6 +8407,9 @@ private:
 		poolSize[1].type = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
 		poolSize[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
+		poolSize[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		poolSize[2].descriptorCount = static_cast<uint32_t>((SCENE_BUFFERS_COUNT + WAVEFRONT_BUFFERS_COUNT + SDF_BAKE_BUFFERS_COUNT + 4) * MAX_FRAMES_IN_FLIGHT);
+
 		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		poolInfo.poolSizeCount = static_cast<uint32_t>(poolSize.size());
 		poolInfo.pPoolSizes = poolSize.data();
@@ -2313,7 +8422,7 @@ private:
 
 	void UpdateDescriptorSet() {
 		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-			std::array<VkWriteDescriptorSet, 2> descriptorWrite{};
+			std::array<VkWriteDescriptorSet, SCENE_BUFFERS_COUNT + WAVEFRONT_BUFFERS_COUNT + SDF_BAKE_BUFFERS_COUNT + 6> descriptorWrite{};
 
 			VkDescriptorBufferInfo bufferInfo{};
 			bufferInfo.buffer = uniformBuffers[i];
@@ -2345,6 +8454,38 @@ private:
 			descriptorWrite[1].pImageInfo = nullptr;
 			descriptorWrite[1].pTexelBufferView = &texelBufferView;
 
+			std::array<VkBuffer, SCENE_BUFFERS_COUNT + WAVEFRONT_BUFFERS_COUNT + SDF_BAKE_BUFFERS_COUNT + 4> storageBuffers{};
+			for (size_t k = 0; k < SCENE_BUFFERS_COUNT; k++) {
+				storageBuffers[k] = sceneBuffers[i][k].buffer;
+			}
+			storageBuffers[SCENE_BUFFERS_COUNT] = CIEXYZ1931Buffer;
+			storageBuffers[SCENE_BUFFERS_COUNT + 1] = pathStateBuffer;
+			storageBuffers[SCENE_BUFFERS_COUNT + 2] = queueBuffer;
+			for (size_t k = 0; k < bakeBuffers.size(); k++) {
+				storageBuffers[SCENE_BUFFERS_COUNT + 3 + k] = bakeBuffers[k];
+			}
+			storageBuffers[SCENE_BUFFERS_COUNT + 3 + bakeBuffers.size()] = marchStatsBuffer.buffer;
+			storageBuffers[SCENE_BUFFERS_COUNT + 4 + bakeBuffers.size()] = coneTileBuffer;
+			storageBuffers[SCENE_BUFFERS_COUNT + 5 + bakeBuffers.size()] = blueNoiseBuffer;
+			storageBuffers[SCENE_BUFFERS_COUNT + 6 + bakeBuffers.size()] = adaptiveBuffer;
+
+			std::array<VkDescriptorBufferInfo, SCENE_BUFFERS_COUNT + WAVEFRONT_BUFFERS_COUNT + SDF_BAKE_BUFFERS_COUNT + 4> storageBufferInfo{};
+			for (size_t k = 0; k < storageBufferInfo.size(); k++) {
+				storageBufferInfo[k].buffer = storageBuffers[k];
+				storageBufferInfo[k].offset = 0;
+				storageBufferInfo[k].range = VK_WHOLE_SIZE;
+
+				descriptorWrite[k + 2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrite[k + 2].dstSet = descriptorSets[i];
+				descriptorWrite[k + 2].dstBinding = static_cast<uint32_t>(k + 2);
+				descriptorWrite[k + 2].dstArrayElement = 0;
+				descriptorWrite[k + 2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				descriptorWrite[k + 2].descriptorCount = 1;
+				descriptorWrite[k + 2].pBufferInfo = &storageBufferInfo[k];
+				descriptorWrite[k + 2].pImageInfo = nullptr;
+				descriptorWrite[k + 2].pTexelBufferView = nullptr;
+			}
+
 			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrite.size()), descriptorWrite.data(), 0, nullptr);
 		}
 	}
@@ -2421,6 +8562,46 @@ private:
 		}
 	}
 
+	void CreateTimestampQueryPool() {
+		// Queue Family Without Valid Timestamp Bits Can't Time Compute Work, GPU Time Is Then Left At Zero
+		QueueFamilyIndices indices = FindQueueFamilies(physicalDevice);
+		uint32_t queueFamiliesCount;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamiliesCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamiliesCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamiliesCount, queueFamilies.data());
+		if (queueFamilies[indices.graphicsComputeFamily.value()].timestampValidBits == 0) {
+			return;
+		}
+
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+		timestampPeriod = deviceProperties.limits.timestampPeriod;
+
+		VkQueryPoolCreateInfo queryPoolInfo{};
+		queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolInfo.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
+
+		if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &timestampQueryPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed To Create Timestamp Query Pool!");
+		}
+		vkResetQueryPool(device, timestampQueryPool, 0, 2 * MAX_FRAMES_IN_FLIGHT);
+	}
+
+	void ReadComputeTime() {
+		// Compute Fence Of Current Frame Has Been Waited On, So Its Previous Timestamps Are Ready Unless It Never Ran
+		if (timestampQueryPool == VK_NULL_HANDLE) {
+			return;
+		}
+		uint64_t timestamps[2];
+		if (vkGetQueryPoolResults(device, timestampQueryPool, 2 * currentFrame, 2, sizeof(timestamps), timestamps,
+		sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+			computeTime = 1e-6f * timestampPeriod * static_cast<float>(timestamps[1] - timestamps[0]);
+			totalComputeTime += computeTime;
+			timedFrames++;
+		}
+	}
+
     void InitVulkan() {
         CreateInstance();
 		SetupDebugMessenger();
@@ -2443,6 +8624,13 @@ private:
 		    CreateIndexBuffer();
 		}
 		CreateUniformBuffer();
+		CreateSceneBuffers();
+		CreateCIEXYZ1931Buffer();
+		CreateBlueNoiseBuffer();
+		CreateWavefrontBuffers(isWavefront ? W * H : 1);
+		CreateSDFBakeBuffers();
+		CreateConeTileBuffer(ConeTilesCount());
+		CreateAdaptiveBuffer(W * H);
 		CreateTexelBuffer();
 		CreateTexelBufferView();
 		if (!OFFSCREENRENDER) {
@@ -2452,6 +8640,7 @@ private:
 		CreateDescriptorSet();
 		CreateCommandBuffer();
 		CreateSyncObjects();
+		CreateTimestampQueryPool();
     }
 
 	void DarkStyle() {
@@ -2694,6 +8883,48 @@ private:
 			cyclides[i].lightID = scene["cyclide"][i]["lightID"];
 		}
 
+		// Coefficients Are Stored By Monomial Names Like "x^2yz", Missing Ones Are Zero
+		polynomials.resize(scene["polynomial"].size());
+		for (size_t i = 0; i < polynomials.size(); i++) {
+			polynomials[i].pos[0] = scene["polynomial"][i]["position"][0];
+			polynomials[i].pos[1] = scene["polynomial"][i]["position"][1];
+			polynomials[i].pos[2] = scene["polynomial"][i]["position"][2];
+
+			polynomials[i].rotation[0] = scene["polynomial"][i]["rotation"][0];
+			polynomials[i].rotation[1] = scene["polynomial"][i]["rotation"][1];
+			polynomials[i].rotation[2] = scene["polynomial"][i]["rotation"][2];
+
+			polynomials[i].scale[0] = scene["polynomial"][i]["scale"][0];
+			polynomials[i].scale[1] = scene["polynomial"][i]["scale"][1];
+			polynomials[i].scale[2] = scene["polynomial"][i]["scale"][2];
+
+			std::fill(std::begin(polynomials[i].coefficients), std::end(polynomials[i].coefficients), 0.0f);
+			for (auto& [name, coefficient] : scene["polynomial"][i]["coefficients"].items()) {
+				polynomials[i].coefficients[ParseMonomial(name)] += coefficient.get<float>();
+			}
+
+			polynomials[i].brad = scene["polynomial"][i]["boundingRadius"];
+
+			polynomials[i].materialID = scene["polynomial"][i]["materialID"];
+		}
+
+		rects.resize(scene["rect"].size());
+		for (size_t i = 0; i < rects.size(); i++) {
+			rects[i].pos[0] = scene["rect"][i]["position"][0];
+			rects[i].pos[1] = scene["rect"][i]["position"][1];
+			rects[i].pos[2] = scene["rect"][i]["position"][2];
+
+			rects[i].rotation[0] = scene["rect"][i]["rotation"][0];
+			rects[i].rotation[1] = scene["rect"][i]["rotation"][1];
+			rects[i].rotation[2] = scene["rect"][i]["rotation"][2];
+
+			rects[i].size[0] = scene["rect"][i]["size"][0];
+			rects[i].size[1] = scene["rect"][i]["size"][1];
+
+			rects[i].materialID = scene["rect"][i]["materialID"];
+			rects[i].lightID = scene["rect"][i]["lightID"];
+		}
+
 		sdfs.resize(scene["sdf"].size());
 		for (size_t i = 0; i < sdfs.size(); i++) {
 			sdfs[i].pos[0] = scene["sdf"][i]["position"][0];
@@ -2707,6 +8938,25 @@ private:
 			sdfs[i].glsl = scene["sdf"][i]["glsl"];
 		}
 
+		// Heightfields Are Baked From glsl If It Is Given, Otherwise Read From The raw File
+		heightfields.resize(scene["heightfield"].size());
+		for (size_t i = 0; i < heightfields.size(); i++) {
+			heightfields[i].pos[0] = scene["heightfield"][i]["position"][0];
+			heightfields[i].pos[1] = scene["heightfield"][i]["position"][1];
+			heightfields[i].pos[2] = scene["heightfield"][i]["position"][2];
+
+			heightfields[i].size[0] = scene["heightfield"][i]["size"][0];
+			heightfields[i].size[1] = scene["heightfield"][i]["size"][1];
+			heightfields[i].size[2] = scene["heightfield"][i]["size"][2];
+
+			heightfields[i].resolution = scene["heightfield"][i]["resolution"];
+
+			heightfields[i].glsl = scene["heightfield"][i].value("glsl", "");
+			heightfields[i].raw = scene["heightfield"][i].value("raw", "");
+
+			heightfields[i].materialID = scene["heightfield"][i]["materialID"];
+		}
+
 		materials.resize(scene["material"].size());
 		for (size_t i = 0; i < materials.size(); i++) {
 			materials[i].reflection[0] = scene["material"][i]["reflection"]["peakWavelength"];
@@ -2833,6 +9083,47 @@ private:
 			scene["cyclide"][i]["lightID"] = cyclides[i].lightID;
 		}
 
+		for (size_t i = 0; i < polynomials.size(); i++) {
+			scene["polynomial"][i]["position"][0] = RoundDecimal((double)polynomials[i].pos[0], 1e5);
+			scene["polynomial"][i]["position"][1] = RoundDecimal((double)polynomials[i].pos[1], 1e5);
+			scene["polynomial"][i]["position"][2] = RoundDecimal((double)polynomials[i].pos[2], 1e5);
+
+			scene["polynomial"][i]["rotation"][0] = RoundDecimal((double)polynomials[i].rotation[0], 1e5);
+			scene["polynomial"][i]["rotation"][1] = RoundDecimal((double)polynomials[i].rotation[1], 1e5);
+			scene["polynomial"][i]["rotation"][2] = RoundDecimal((double)polynomials[i].rotation[2], 1e5);
+
+			scene["polynomial"][i]["scale"][0] = RoundDecimal((double)polynomials[i].scale[0], 1e5);
+			scene["polynomial"][i]["scale"][1] = RoundDecimal((double)polynomials[i].scale[1], 1e5);
+			scene["polynomial"][i]["scale"][2] = RoundDecimal((double)polynomials[i].scale[2], 1e5);
+
+			scene["polynomial"][i]["coefficients"] = nlohmann::ordered_json::object();
+			for (int j = POLYNOMIAL_MONOMIALS - 1; j >= 0; j--) {
+				if (polynomials[i].coefficients[j] != 0.0f) {
+					scene["polynomial"][i]["coefficients"][MonomialName(j)] = RoundDecimal((double)polynomials[i].coefficients[j], 1e5);
+				}
+			}
+
+			scene["polynomial"][i]["boundingRadius"] = RoundDecimal((double)polynomials[i].brad, 1e5);
+
+			scene["polynomial"][i]["materialID"] = polynomials[i].materialID;
+		}
+
+		for (size_t i = 0; i < rects.size(); i++) {
+			scene["rect"][i]["position"][0] = RoundDecimal((double)rects[i].pos[0], 1e5);
+			scene["rect"][i]["position"][1] = RoundDecimal((double)rects[i].pos[1], 1e5);
+			scene["rect"][i]["position"][2] = RoundDecimal((double)rects[i].pos[2], 1e5);
+
+			scene["rect"][i]["rotation"][0] = RoundDecimal((double)rects[i].rotation[0], 1e5);
+			scene["rect"][i]["rotation"][1] = RoundDecimal((double)rects[i].rotation[1], 1e5);
+			scene["rect"][i]["rotation"][2] = RoundDecimal((double)rects[i].rotation[2], 1e5);
+
+			scene["rect"][i]["size"][0] = RoundDecimal((double)rects[i].size[0], 1e5);
+			scene["rect"][i]["size"][1] = RoundDecimal((double)rects[i].size[1], 1e5);
+
+			scene["rect"][i]["materialID"] = rects[i].materialID;
+			scene["rect"][i]["lightID"] = rects[i].lightID;
+		}
+
 		for (size_t i = 0; i < sdfs.size(); i++) {
 			scene["sdf"][i]["position"][0] = RoundDecimal((double)sdfs[i].pos[0], 1e5);
 			scene["sdf"][i]["position"][1] = RoundDecimal((double)sdfs[i].pos[1], 1e5);
@@ -2845,6 +9136,26 @@ private:
 			scene["sdf"][i]["glsl"] = sdfs[i].glsl;
 		}
 
+		for (size_t i = 0; i < heightfields.size(); i++) {
+			scene["heightfield"][i]["position"][0] = RoundDecimal((double)heightfields[i].pos[0], 1e5);
+			scene["heightfield"][i]["position"][1] = RoundDecimal((double)heightfields[i].pos[1], 1e5);
+			scene["heightfield"][i]["position"][2] = RoundDecimal((double)heightfields[i].pos[2], 1e5);
+
+			scene["heightfield"][i]["size"][0] = RoundDecimal((double)heightfields[i].size[0], 1e5);
+			scene["heightfield"][i]["size"][1] = RoundDecimal((double)heightfields[i].size[1], 1e5);
+			scene["heightfield"][i]["size"][2] = RoundDecimal((double)heightfields[i].size[2], 1e5);
+
+			scene["heightfield"][i]["resolution"] = heightfields[i].resolution;
+
+			if (!heightfields[i].glsl.empty()) {
+				scene["heightfield"][i]["glsl"] = heightfields[i].glsl;
+			} else {
+				scene["heightfield"][i]["raw"] = heightfields[i].raw;
+			}
+
+			scene["heightfield"][i]["materialID"] = heightfields[i].materialID;
+		}
+
 		for (size_t i = 0; i < materials.size(); i++) {
 			scene["material"][i]["reflection"]["peakWavelength"] = RoundDecimal((double)materials[i].reflection[0], 1e5);
 			scene["material"][i]["reflection"]["sigma"] = RoundDecimal((double)materials[i].reflection[1], 1e5);
@@ -2935,6 +9246,9 @@ private:
 		static box newBox = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, 1, 0 };
 		static lens newLens = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, 1.0f, 1.0f, 0.0f, true, 1, 0 };
 		static cyclide newCyclide = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, 3.36, -3.17, -1.06, -1.50, 1, 0 };
+		// Unit Sphere x^2 + y^2 + z^2 - 1
+		static polynomial newPolynomial = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { -1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f }, 1.05f, 1 };
+		static rect newRect = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f }, 1, 0 };
 		static sdf newSDF = { { 0.0f, 0.0f, 0.0f }, { 2.0f, 2.0f, 2.0f }, R"(
 float sdf(in vec3 p){
 	return length(p) - 1.0;
@@ -2961,6 +9275,7 @@ float sdfmaterial(in vec3 p)
 			ImGui::Begin("Scene", NULL, WinFlags);
 			ImGui::SetWindowPos(ImVec2(W - ImGui::GetWindowWidth(), 0));
 			ImGui::Text("Render Time: %0.3f ms (%0.1f FPS)", 1000.0f * frameTime, 1.0f / frameTime);
+			ImGui::Text("GPU Time: %0.3f ms", computeTime);
 			ImGui::PlotLines("", framesGraph.data(), (int)framesGraph.size(), 0, NULL, 0.0f, 30.0f, ImVec2(303, 100));
 			ImGui::Text("Resolution: (%i, %i) px", W, H);
 			ImGui::Text("Samples: %i", currentSamples);
@@ -2968,9 +9283,21 @@ float sdfmaterial(in vec3 p)
 			ImGui::Text("Camera Pos: (%0.3f, %0.3f, %0.3f)", camera.pos.x, camera.pos.y, camera.pos.z);
 			isVSyncChanged = ImGui::Checkbox("VSync", &VSync);
 			ImGui::Checkbox("Lock Camera", &isCameraLocked);
+			isUpdateUBO |= ImGui::Checkbox("BVH", &isUseBVH);
+			isReset |= ImGui::Checkbox("Wavefront", &isWavefront);
+			if (isWavefront) {
+				ImGui::SameLine();
+				ImGui::Checkbox("Sort Rays", &isRaySorting);
+			}
+			isReset |= ImGui::Combo("Sampler", &samplerType, "PCG32\0Sobol\0Blue Noise\0");
 			ImGui::DragFloat("Min Latency", &minFrameTime, 1.0f, 0.0f, 1e7f);
 			isReset |= ImGui::DragInt("Samples/Frame", &samplesPerFrame, 0.02f, 1, 100);
 			isReset |= ImGui::DragInt("Path Length", &pathLength, 0.02f, 1, 100000);
+			// Pixel Statistics Aren't Kept While Adaptive Sampling Is Off And Converged Pixels Stop At Their Target, So Both Restart Accumulation
+			isReset |= ImGui::Checkbox("Adaptive Sampling", &isAdaptiveSampling);
+			if (isAdaptiveSampling) {
+				isReset |= ImGui::DragFloat("Target Error", &adaptiveThreshold, 0.0001f, 0.0001f, 1.0f, "%0.4f");
+			}
 			isLoadScene |= ImGui::Button("Load Scene", ImVec2(303, 0));
 			isSaveScene |= ImGui::Button("Save Scene", ImVec2(303, 0));
 			isSaveRender |= ImGui::Button("Save Render", ImVec2(303, 0));
@@ -3062,6 +9389,8 @@ float sdfmaterial(in vec3 p)
 				int numBoxes = (int)boxes.size();
 				int numLenses = (int)lenses.size();
 				int numCyclides = (int)cyclides.size();
+				int numPolynomials = (int)polynomials.size();
+				int numRects = (int)rects.size();
 
 				int id = objectSelection;
 				if (IsInRange(id, 0, numSpheres - 1)) {
@@ -3116,9 +9445,43 @@ float sdfmaterial(in vec3 p)
 					isUpdateUBO |= ImGui::DragFloat("Bounding Radius", &cyclides[id].brad, 0.01f, 0.0f, 1e7f);
 					isUpdateUBO |= ImGui::DragInt("Material ID", &cyclides[id].materialID, 0.02f, 1, numMaterials);
 					isUpdateUBO |= ImGui::DragInt("Light ID", &cyclides[id].lightID, 0.02f, 0, numLights);
+					isUpdateUBO |= ImGui::Checkbox("Quartic Interval Test", &isCyclideIntervalTest);
+					ImGui::SameLine();
+					ImGui::Checkbox("Count Solves", &isCountMarchSteps);
+					if (isCountMarchSteps) {
+						// Solves Are Counted Over Every Cyclide, Tests Are Rays Passing Bounding Sphere
+						gpuMarchStats* marchStats = (gpuMarchStats*)marchStatsBuffer.mapped;
+						ImGui::Text("Quartic Solves: %0.2f%% Of Tests, %0.2f%% Miss", (float)(100.0 * marchStats->quarticSolves / std::max(marchStats->cyclideTests, (uint64_t)1)), (float)(100.0 * marchStats->quarticMisses / std::max(marchStats->quarticSolves, (uint64_t)1)));
+					}
 				}
 
 				id -= numCyclides;
+				if (IsInRange(id, 0, numPolynomials - 1)) {
+					ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Polynomial %i", id + 1);
+					isUpdateUBO |= ImGui::DragFloat3("Position", polynomials[id].pos, 0.01f);
+					isUpdateUBO |= ImGui::DragFloat3("Rotation", polynomials[id].rotation, 0.1f);
+					isUpdateUBO |= ImGui::DragFloat3("Scale", polynomials[id].scale, 0.01f, 1e-3f, 1e7f);
+					if (ImGui::TreeNode("Coefficients")) {
+						for (int i = POLYNOMIAL_MONOMIALS - 1; i >= 0; i--) {
+							isUpdateUBO |= ImGui::DragFloat(MonomialName(i).c_str(), &polynomials[id].coefficients[i], 0.01f);
+						}
+						ImGui::TreePop();
+					}
+					isUpdateUBO |= ImGui::DragFloat("Bounding Radius", &polynomials[id].brad, 0.01f, 0.0f, 1e7f);
+					isUpdateUBO |= ImGui::DragInt("Material ID", &polynomials[id].materialID, 0.02f, 1, numMaterials);
+				}
+
+				id -= numPolynomials;
+				if (IsInRange(id, 0, numRects - 1)) {
+					ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Rect %i", id + 1);
+					isUpdateUBO |= ImGui::DragFloat3("Position", rects[id].pos, 0.01f);
+					isUpdateUBO |= ImGui::DragFloat3("Rotation", rects[id].rotation, 0.1f);
+					isUpdateUBO |= ImGui::DragFloat2("Size", rects[id].size, 0.01f, 0.0f, 1e7f);
+					isUpdateUBO |= ImGui::DragInt("Material ID", &rects[id].materialID, 0.02f, 1, numMaterials);
+					isUpdateUBO |= ImGui::DragInt("Light ID", &rects[id].lightID, 0.02f, 0, numLights);
+				}
+
+				id -= numRects;
 
 				ImGui::Separator();
 
@@ -3130,6 +9493,8 @@ float sdfmaterial(in vec3 p)
 					ItemsTable("Box ", objectSelection, numSpheres + numPlanes, numBoxes, true);
 					ItemsTable("Lens ", objectSelection, numSpheres + numPlanes + numBoxes, numLenses, true);
 					ItemsTable("Cyclide ", objectSelection, numSpheres + numPlanes + numBoxes + numLenses, numCyclides, true);
+					ItemsTable("Polynomial ", objectSelection, numSpheres + numPlanes + numBoxes + numLenses + numCyclides, numPolynomials, true);
+					ItemsTable("Rect ", objectSelection, numSpheres + numPlanes + numBoxes + numLenses + numCyclides + numPolynomials, numRects, true);
 					ImGui::EndTable();
 				}
 				ImGui::Separator();
@@ -3169,6 +9534,20 @@ float sdfmaterial(in vec3 p)
 					isUpdateUBO = true;
 				}
 
+				if (ImGui::Button("Add New Polynomial", ImVec2(303, 0))) {
+					polynomials.push_back(newPolynomial);
+
+					objectSelection = numSpheres + numPlanes + numBoxes + numLenses + numCyclides + numPolynomials;
+					isUpdateUBO = true;
+				}
+
+				if (ImGui::Button("Add New Rect", ImVec2(303, 0))) {
+					rects.push_back(newRect);
+
+					objectSelection = numSpheres + numPlanes + numBoxes + numLenses + numCyclides + numPolynomials + numRects;
+					isUpdateUBO = true;
+				}
+
 				if (ImGui::Button("Delete Object", ImVec2(303, 0))) {
 					id = objectSelection;
 					if (IsInRange(id, 0, numSpheres - 1)) {
@@ -3210,6 +9589,22 @@ float sdfmaterial(in vec3 p)
 						}
 					}
 
+					id -= numCyclides;
+					if (IsInRange(id, 0, numPolynomials - 1)) {
+						polynomials.erase(std::next(polynomials.begin(), id));
+						if (objectSelection > 0) {
+							objectSelection--;
+						}
+					}
+
+					id -= numPolynomials;
+					if (IsInRange(id, 0, numRects - 1)) {
+						rects.erase(std::next(rects.begin(), id));
+						if (objectSelection > 0) {
+							objectSelection--;
+						}
+					}
+
 					isUpdateUBO = true;
 				}
 			}
@@ -3218,11 +9613,61 @@ float sdfmaterial(in vec3 p)
 			if (ImGui::CollapsingHeader("SDFs")) {
 				int numSDFs = (int)sdfs.size();
 
+				if (ImGui::Checkbox("Bake SDFs", &isBakeSDF)) {
+					isUpdateUBO = true;
+					isRebakeSDF = true;
+				}
+				ImGui::SameLine();
+				ImGui::Checkbox("Count Steps", &isCountMarchSteps);
+				ImGui::Checkbox("Cone Pre-Pass", &isConePrepass);
+				ImGui::SameLine();
+				if (ImGui::Checkbox("Footprint Marching", &isFootprintMarching)) {
+					KeepMarchSteps(isFootprintMarching ? "Footprint Marching" : "Fixed Marching");
+					isUpdateUBO = true;
+				}
+				ImGui::SameLine();
+				ImGui::Checkbox("Shrink Boxes On Load", &isShrinkSDFBoxes);
+				isRecompile |= ImGui::Checkbox("Dual Number Normals", &isDualSDFNormals);
+				if (isBakeSDF) {
+					ImGui::Text("Bake: %0.3f ms, %i Bricks, %0.3f MB", bakeTime, numBakeBricks, SDFBakeMemory() / 1048576.0);
+				}
+				if (isCountMarchSteps) {
+					gpuMarchStats* marchStats = (gpuMarchStats*)marchStatsBuffer.mapped;
+					ImGui::Text("Steps: %0.2f/Ray", (float)((double)marchStats->marchSteps / std::max(marchStats->marchedRays, (uint64_t)1)));
+					if (marchStepsBefore >= 0.0f) {
+						ImGui::SameLine();
+						ImGui::Text("(%0.2f/Ray Before %s)", marchStepsBefore, marchStepsChange.c_str());
+					}
+					ImGui::Text("Out Of Steps: %0.3f%% Of Rays", (float)(100.0 * marchStats->exhaustedRays / std::max(marchStats->marchedRays, (uint64_t)1)));
+				}
+				if (pipelineBuild.valid()) {
+					ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Interpreting %i SDFs While Compiling", (int)sdfCodeOffsets.size());
+				} else if (isPipelineBuildFailed) {
+					ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Compute Shader Failed To Compile");
+				}
+				ImGui::Separator();
+
 				int id = sdfSelection;
 				if (IsInRange(id, 0, numSDFs - 1)) {
 					ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "SDF %i", id + 1);
-					isUpdateUBO |= ImGui::DragFloat3("Position", sdfs[id].pos, 0.01f);
-					isUpdateUBO |= ImGui::DragFloat3("Bounding Box Size", sdfs[id].size, 0.01f, 0.0f, 1e7f);
+					if (sdfMetadatas.count(sdfs[id].glsl)) {
+						ImGui::Text("Lipschitz Bound: %.3f", sdfMetadatas[sdfs[id].glsl].lipschitz);
+						if (sdfMetadatas[sdfs[id].glsl].isDistanceEstimator) {
+							ImGui::Text("Distance Estimator, Not Baked Or Cone Bounded");
+						}
+					}
+					if (ImGui::DragFloat3("Position", sdfs[id].pos, 0.01f)) {
+						isUpdateUBO = true;
+						isRebakeSDF = true;
+					}
+					if (ImGui::DragFloat3("Bounding Box Size", sdfs[id].size, 0.01f, 0.0f, 1e7f)) {
+						isUpdateUBO = true;
+						isRebakeSDF = true;
+					}
+					if (ImGui::Button("Shrink Bounding Box", ImVec2(303, 0))) {
+						KeepMarchSteps("Shrinking Box");
+						ShrinkSDFBox(id);
+					}
 					isLoadSDF |= ImGui::Button("Change SDF", ImVec2(303, 0));
 					isSaveSDF |= ImGui::Button("Save SDF", ImVec2(303, 0));
 				}
@@ -3242,7 +9687,8 @@ float sdfmaterial(in vec3 p)
 
 					sdfSelection = numSDFs;
 					isUpdateUBO = true;
-					isRecompile = true;
+					isSDFChanged = true;
+					isRebakeSDF = true;
 				}
 
 				if (ImGui::Button("Delete SDF", ImVec2(303, 0))) {
@@ -3254,9 +9700,67 @@ float sdfmaterial(in vec3 p)
 						}
 					}
 
+					// Remaining SDFs Are Still In The Compute Pipelines, Only Their Bake Offsets Move
+					isUpdateUBO = true;
+					isRebakeSDF = true;
+				}
+			}
+			ImGui::Separator();
+
+			if (ImGui::CollapsingHeader("Heightfields")) {
+				int numHeightfields = (int)heightfields.size();
+
+				// Widgets Share Labels With Those Of SDFs
+				ImGui::PushID("Heightfields");
+				int id = heightfieldSelection;
+				if (IsInRange(id, 0, numHeightfields - 1)) {
+					ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Heightfield %i (%s)", id + 1, heightfields[id].glsl.empty() ? heightfields[id].raw.c_str() : "glsl");
+					isUpdateUBO |= ImGui::DragFloat3("Position", heightfields[id].pos, 0.01f);
+					if (ImGui::DragFloat3("Size", heightfields[id].size, 0.01f, 0.0f, 1e7f)) {
+						isUpdateUBO = true;
+						isHeightfieldChanged = true;
+					}
+					ImGui::DragInt("Resolution", &heightfields[id].resolution, 1.0f, 1, HEIGHTFIELD_MAX_RESOLUTION);
+					if (ImGui::IsItemDeactivatedAfterEdit()) {
+						isUpdateUBO = true;
+						isHeightfieldChanged = true;
+					}
+					isUpdateUBO |= ImGui::DragInt("Material ID", &heightfields[id].materialID, 0.02f, 1, numMaterials);
+				}
+
+				ImGui::Separator();
+
+				if (ImGui::BeginTable("Heightfields Table", 1)) {
+					ImGui::TableSetupColumn("Heightfield");
+					ImGui::TableHeadersRow();
+					ItemsTable("Heightfield ", heightfieldSelection, 0, numHeightfields, true);
+					ImGui::EndTable();
+				}
+				ImGui::Separator();
+
+				// Heightfield Over The Box Of Selected SDF, Which Should Be Of The Form p.y - h(p.xz)
+				if (ImGui::Button("Bake Heightfield From SDF", ImVec2(303, 0)) && IsInRange(sdfSelection, 0, (int)sdfs.size() - 1)) {
+					const sdf& object = sdfs[sdfSelection];
+					heightfields.push_back({ { object.pos[0], object.pos[1], object.pos[2] }, { object.size[0], object.size[1], object.size[2] }, 512, object.glsl, "", 1 });
+
+					heightfieldSelection = numHeightfields;
+					isUpdateUBO = true;
+					isHeightfieldChanged = true;
+				}
+
+				if (ImGui::Button("Delete Heightfield", ImVec2(303, 0))) {
+					id = heightfieldSelection;
+					if (IsInRange(id, 0, numHeightfields - 1)) {
+						heightfields.erase(std::next(heightfields.begin(), id));
+						if (heightfieldSelection > 0) {
+							heightfieldSelection--;
+						}
+					}
+
 					isUpdateUBO = true;
-					isRecompile = true;
+					isHeightfieldChanged = true;
 				}
+				ImGui::PopID();
 			}
 			ImGui::Separator();
 
@@ -3333,6 +9837,24 @@ float sdfmaterial(in vec3 p)
 							}
 						}
 
+						for (polynomial& polynomial : polynomials) {
+							if ((polynomial.materialID > materialSelection) && (polynomial.materialID > 1)) {
+								polynomial.materialID--;
+							}
+						}
+
+						for (rect& rect : rects) {
+							if ((rect.materialID > materialSelection) && (rect.materialID > 1)) {
+								rect.materialID--;
+							}
+						}
+
+						for (heightfield& heightfield : heightfields) {
+							if ((heightfield.materialID > materialSelection) && (heightfield.materialID > 1)) {
+								heightfield.materialID--;
+							}
+						}
+
 						if (materialSelection > 0) {
 							materialSelection--;
 						}
@@ -3405,6 +9927,12 @@ float sdfmaterial(in vec3 p)
 							}
 						}
 
+						for (rect& rect : rects) {
+							if ((rect.lightID > lightSelection) && (rect.lightID > 1)) {
+								rect.lightID--;
+							}
+						}
+
 						if (lightSelection > 0) {
 							lightSelection--;
 						}
@@ -3448,8 +9976,11 @@ float sdfmaterial(in vec3 p)
 
 			objectSelection = 0;
 			materialSelection = 0;
+			heightfieldSelection = 0;
 			isUpdateUBO = true;
-			isRecompile = true;
+			isSDFChanged = true;
+			isHeightfieldChanged = true;
+			isRebakeSDF = true;
 
 			vkDeviceWaitIdle(device);
 
@@ -3475,7 +10006,9 @@ float sdfmaterial(in vec3 p)
 		std::vector<std::string> SDFDir = pfd::open_file("Load SDF", "", {"All Files", "*"}, pfd::opt::none).result();
 		if (!SDFDir.empty()) {
 			sdfs[sdfSelection].glsl = ReadFile(SDFDir.at(0));
-			isRecompile = true;
+			isUpdateUBO = true;
+			isSDFChanged = true;
+			isRebakeSDF = true;
 		}
 	}
 
@@ -3492,8 +10025,10 @@ float sdfmaterial(in vec3 p)
 	    std::string renderDir = pfd::save_file("Save Render", "", {"PPM", "*.ppm"}, pfd::opt::force_overwrite).result();
 
 		if (!renderDir.empty()) {
-            void* mappedMemory;
-           	vkMapMemory(device, texelBufferMemory, 0, VK_WHOLE_SIZE, 0, &mappedMemory);
+            void* mappedMemory = cpuTexels.data();
+			if (!CPURENDER) {
+           		vkMapMemory(device, texelBufferMemory, 0, VK_WHOLE_SIZE, 0, &mappedMemory);
+			}
 
            	float* pixels = static_cast<float*>(mappedMemory);
            	char* pixelsRGB = new char[W * H * 3];
@@ -3512,7 +10047,9 @@ float sdfmaterial(in vec3 p)
 
            	SavePPM(renderDir, W, H, pixelsRGB);
 
-           	vkUnmapMemory(device, texelBufferMemory);
+			if (!CPURENDER) {
+           		vkUnmapMemory(device, texelBufferMemory);
+			}
            	delete[] pixelsRGB;
 		}
 	}
@@ -3568,19 +10105,168 @@ float sdfmaterial(in vec3 p)
 		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
 		graphicsPipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
 
-		vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstant), &pushConstant);
+		vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstant), &pushConstant);
+
+		vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+
+		vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+
+		ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+
+		vkCmdEndRenderPass(commandBuffer);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed To Record Graphics Command Buffer!");
+		}
+	}
+
+	void WavefrontBarrier(VkCommandBuffer commandBuffer) {
+		// Makes Path States And Queues Written By Previous Pass Visible To The Next Pass And Its Indirect Dispatch
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+		0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+
+	void ResetWavefrontQueue(VkCommandBuffer commandBuffer, int queue) {
+		// Empty Queue Dispatches No Work Groups Until Paths Are Pushed Into It
+		gpuQueueHeader header{};
+		header.dispatch.x = 0;
+		header.dispatch.y = 1;
+		header.dispatch.z = 1;
+		header.count = 0;
+
+		vkCmdUpdateBuffer(commandBuffer, queueBuffer, queue * sizeof(gpuQueueHeader), sizeof(gpuQueueHeader), &header);
+	}
+
+	void ResetSortBuckets(VkCommandBuffer commandBuffer) {
+		// Bucket Counts Follow Queue Headers And Are Counted Again By Every Intersection Pass
+		vkCmdFillBuffer(commandBuffer, queueBuffer, 4 * sizeof(gpuQueueHeader), sizeof(uint32_t) * SORT_BUCKETS_COUNT, 0);
+	}
+
+	void DispatchWavefrontQueue(VkCommandBuffer commandBuffer, int stage, int queue) {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[stage]);
+
+		vkCmdDispatchIndirect(commandBuffer, queueBuffer, queue * sizeof(gpuQueueHeader));
+
+		WavefrontBarrier(commandBuffer);
+	}
+
+	bool IsAdaptiveUpdateFrame() {
+		return pushConstant.isAdaptive && (((adaptiveFrames - 1) % ADAPTIVE_UPDATE_FRAMES) == 0);
+	}
+
+	void DispatchPixels(VkCommandBuffer commandBuffer) {
+		// Adaptive Sampling Covers Only The List Of Unconverged Pixels, Otherwise Every Pixel Has An Invocation
+		if (pushConstant.isAdaptive) {
+			vkCmdDispatchIndirect(commandBuffer, adaptiveBuffer, 0);
+		} else {
+			vkCmdDispatch(commandBuffer, static_cast<uint32_t>(std::ceil(W / 16.0)), static_cast<uint32_t>(std::ceil(H / 16.0)), 1);
+		}
+	}
+
+	void RecordAdaptiveCommands(VkCommandBuffer commandBuffer) {
+		// Rebuilds The List Of Unconverged Pixels From Statistics Accumulated So Far, Pixels Stay In It Until The Next Rebuild
+		gpuQueueHeader header{};
+		header.dispatch.x = 0;
+		header.dispatch.y = 1;
+		header.dispatch.z = 1;
+		header.count = 0;
+
+		// Previous Frame May Still Be Reading The List
+		WavefrontBarrier(commandBuffer);
+		vkCmdUpdateBuffer(commandBuffer, adaptiveBuffer, 0, sizeof(gpuQueueHeader), &header);
+		WavefrontBarrier(commandBuffer);
+
+		vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstant), &pushConstant);
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_ADAPTIVE_COMPACT]);
+		vkCmdDispatch(commandBuffer, static_cast<uint32_t>(std::ceil(W / 16.0)), static_cast<uint32_t>(std::ceil(H / 16.0)), 1);
+		WavefrontBarrier(commandBuffer);
+
+		// Header Of The Rebuilt List Is Copied Out For The Host To Count Unconverged Pixels Once The Frame Is Done
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		VkBufferCopy copyRegion{};
+		copyRegion.size = sizeof(gpuQueueHeader);
+		vkCmdCopyBuffer(commandBuffer, adaptiveBuffer, adaptiveHeaderBuffer.buffer, 1, &copyRegion);
+
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
 
-		vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+	void RecordConeTileCommands(VkCommandBuffer commandBuffer) {
+		// One Invocation Per Tile Of Pixels, Cones Are Marched Once Per Frame And Used By Camera Rays Of Every Sample
+		uint32_t groupsX = static_cast<uint32_t>(std::ceil(W / (16.0 * CONE_TILE_SIZE)));
+		uint32_t groupsY = static_cast<uint32_t>(std::ceil(H / (16.0 * CONE_TILE_SIZE)));
 
-		vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+		// Previous Frame May Still Be Reading The Cones
+		WavefrontBarrier(commandBuffer);
 
-		ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
+		vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstant), &pushConstant);
 
-		vkCmdEndRenderPass(commandBuffer);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_CONE_TILES]);
+		vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+		WavefrontBarrier(commandBuffer);
+	}
 
-		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-			throw std::runtime_error("Failed To Record Graphics Command Buffer!");
+	void RecordWavefrontCommands(VkCommandBuffer commandBuffer) {
+		// Every Sample Starts One Path Per Pixel, Then Every Bounce Runs Intersection, Shading And Shadow Ray Passes Over The Queues
+		// Passes Are Sized By Indirect Dispatch, So Terminated Paths Don't Take Any Lanes And Sphere Tracing Doesn't Stall Shading
+		PushConstantValues stageConstant = pushConstant;
+
+		// Previous Frame May Still Be Reading The Queues
+		WavefrontBarrier(commandBuffer);
+
+		for (int i = 0; i < samplesPerFrame; i++) {
+			ResetWavefrontQueue(commandBuffer, 0);
+			WavefrontBarrier(commandBuffer);
+
+			stageConstant.sampleIndex = i;
+			stageConstant.bounce = 0;
+			vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(stageConstant), &stageConstant);
+
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_GENERATE]);
+			DispatchPixels(commandBuffer);
+			WavefrontBarrier(commandBuffer);
+
+			for (int k = 0; k < pathLength; k++) {
+				// Rays Of This Bounce Are In Queue k % 2, Shading Fills The Other One
+				ResetWavefrontQueue(commandBuffer, 1 - (k % 2));
+				ResetWavefrontQueue(commandBuffer, QUEUE_SHADOW);
+				ResetSortBuckets(commandBuffer);
+				WavefrontBarrier(commandBuffer);
+
+				stageConstant.bounce = k;
+				vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(stageConstant), &stageConstant);
+
+				DispatchWavefrontQueue(commandBuffer, STAGE_INTERSECT, k % 2);
+				if (isRaySorting) {
+					// Rays Are Reordered By Hit Type And Material, So Neighbouring Lanes Of Shading Take The Same Branches
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_SORT_SCAN]);
+					vkCmdDispatch(commandBuffer, 1, 1, 1);
+					WavefrontBarrier(commandBuffer);
+
+					DispatchWavefrontQueue(commandBuffer, STAGE_SORT_SCATTER, k % 2);
+					DispatchWavefrontQueue(commandBuffer, STAGE_SHADE, QUEUE_SORTED);
+				} else {
+					DispatchWavefrontQueue(commandBuffer, STAGE_SHADE, k % 2);
+				}
+				DispatchWavefrontQueue(commandBuffer, STAGE_SHADOW, QUEUE_SHADOW);
+			}
 		}
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_RESOLVE]);
+		DispatchPixels(commandBuffer);
 	}
 
 	void RecordComputeCommandBuffer(VkCommandBuffer commandBuffer) {
@@ -3593,14 +10279,35 @@ float sdfmaterial(in vec3 p)
 			throw std::runtime_error("Failed To Begin Recording Compute Command Buffer!");
 		}
 
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+		if (timestampQueryPool != VK_NULL_HANDLE) {
+			vkCmdResetQueryPool(commandBuffer, timestampQueryPool, 2 * currentFrame, 2);
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, 2 * currentFrame);
+		}
 
 		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
 		computePipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
 
-		vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstant), &pushConstant);
+		if (pushConstant.isConePrepass) {
+			RecordConeTileCommands(commandBuffer);
+		}
 
-		vkCmdDispatch(commandBuffer, static_cast<uint32_t>(std::ceil(W / 16.0)), static_cast<uint32_t>(std::ceil(H / 16.0)), 1);
+		if (IsAdaptiveUpdateFrame()) {
+			RecordAdaptiveCommands(commandBuffer);
+		}
+
+		if (isWavefront) {
+			RecordWavefrontCommands(commandBuffer);
+		} else {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelines[STAGE_MEGAKERNEL]);
+
+			vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstant), &pushConstant);
+
+			DispatchPixels(commandBuffer);
+		}
+
+		if (timestampQueryPool != VK_NULL_HANDLE) {
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, 2 * currentFrame + 1);
+		}
 
 		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
 			throw std::runtime_error("Failed To Record Compute Command Buffer!");
@@ -3639,167 +10346,528 @@ float sdfmaterial(in vec3 p)
 		UpdateDescriptorSet();
 	}
 
+	void CollectBVHPrimitives() {
+		// Bounding Box Of Every Sphere, Box, Lens, Cyclide, Polynomial And Rect, Planes Are Unbounded So They Are Left Out
+		// Types Follow The Order Of numObjects, Polynomials Are Type 6 Since SDFs Are Type 5, Rects Are Type 7
+		bvhPrimitives.clear();
+
+		for (int i = 0; i < spheres.size(); i++) {
+			float radius = spheres[i].radius;
+			AddBVHPrimitive(glm::vec3(spheres[i].pos[0], spheres[i].pos[1], spheres[i].pos[2]), radius, 0, i);
+		}
+
+		for (int i = 0; i < boxes.size(); i++) {
+			// Bounding Sphere Of Box, Same As The One Used In Shader
+			float radius = 0.5f * glm::length(glm::vec3(boxes[i].size[0], boxes[i].size[1], boxes[i].size[2]));
+			AddBVHPrimitive(glm::vec3(boxes[i].pos[0], boxes[i].pos[1], boxes[i].pos[2]), radius, 2, i);
+		}
+
+		for (int i = 0; i < lenses.size(); i++) {
+			// Bounding Sphere Of Lens, Same As The One Used In Shader
+			float radius = 0.0f;
+			if (lenses[i].isConverging) {
+				radius = glm::sqrt(lenses[i].radius * lenses[i].radius + 0.25f * lenses[i].thickness * lenses[i].thickness);
+			} else {
+				radius = 0.5f * lenses[i].thickness + 2.0f * lenses[i].focalLength - glm::sqrt(4.0f * lenses[i].focalLength * lenses[i].focalLength - lenses[i].radius * lenses[i].radius);
+				radius = glm::sqrt(radius * radius + lenses[i].radius * lenses[i].radius);
+			}
+			AddBVHPrimitive(glm::vec3(lenses[i].pos[0], lenses[i].pos[1], lenses[i].pos[2]), radius, 3, i);
+		}
+
+		for (int i = 0; i < cyclides.size(); i++) {
+			// World Bounds Of The Oriented Bounding Box, Which Is Tighter Than Bounding Sphere For Flattened Cyclides
+			glm::vec3 localMin, localMax;
+			CyclideLocalBounds(cyclides[i], localMin, localMax);
+			glm::vec3 center = 0.5f * (localMin + localMax);
+			glm::vec3 halfSize = 0.5f * (localMax - localMin);
+			glm::mat3 worldFromLocal = RotationMatrix(glm::vec3(cyclides[i].rotation[0], cyclides[i].rotation[1], cyclides[i].rotation[2]));
+			for (int j = 0; j < 3; j++) {
+				worldFromLocal[j] *= cyclides[i].scale[j];
+			}
+			center = glm::vec3(cyclides[i].pos[0], cyclides[i].pos[1], cyclides[i].pos[2]) + worldFromLocal * glm::vec3(center.x, center.z, center.y);
+			halfSize = glm::abs(worldFromLocal[0]) * halfSize.x + glm::abs(worldFromLocal[1]) * halfSize.z + glm::abs(worldFromLocal[2]) * halfSize.y;
+			AddBVHPrimitive(center, halfSize, 4, i);
+		}
+
+		for (int i = 0; i < polynomials.size(); i++) {
+			float radius = polynomials[i].brad * glm::max(glm::max(polynomials[i].scale[0], polynomials[i].scale[1]), polynomials[i].scale[2]);
+			AddBVHPrimitive(glm::vec3(polynomials[i].pos[0], polynomials[i].pos[1], polynomials[i].pos[2]), radius, 6, i);
+		}
+
+		for (int i = 0; i < rects.size(); i++) {
+			// World Bounds Of The Rotated Rectangle, Padded Since It Is Flat
+			glm::mat3 worldFromLocal = RotationMatrix(glm::vec3(rects[i].rotation[0], rects[i].rotation[1], rects[i].rotation[2]));
+			glm::vec3 halfSize = 0.5f * (glm::abs(worldFromLocal[0]) * rects[i].size[0] + glm::abs(worldFromLocal[2]) * rects[i].size[1]) + 1e-4f;
+			AddBVHPrimitive(glm::vec3(rects[i].pos[0], rects[i].pos[1], rects[i].pos[2]), halfSize, 7, i);
+		}
+	}
+
+	void AddBVHPrimitive(glm::vec3 pos, float radius, int type, int index) {
+		AddBVHPrimitive(pos, glm::vec3(glm::abs(radius)), type, index);
+	}
+
+	void AddBVHPrimitive(glm::vec3 pos, glm::vec3 halfSize, int type, int index) {
+		bvhPrimitive primitive{};
+		primitive.boundsMin = pos - halfSize;
+		primitive.boundsMax = pos + halfSize;
+		primitive.centroid = pos;
+		primitive.type = type;
+		primitive.index = index;
+		bvhPrimitives.push_back(primitive);
+	}
+
+	void SubdivideBVHNode(int nodeIndex, int first, int count, int depth) {
+		glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+		glm::vec3 centroidMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 centroidMax = glm::vec3(-std::numeric_limits<float>::max());
+		for (int i = first; i < (first + count); i++) {
+			boundsMin = glm::min(boundsMin, bvhPrimitives[i].boundsMin);
+			boundsMax = glm::max(boundsMax, bvhPrimitives[i].boundsMax);
+			centroidMin = glm::min(centroidMin, bvhPrimitives[i].centroid);
+			centroidMax = glm::max(centroidMax, bvhPrimitives[i].centroid);
+		}
+		for (int i = 0; i < 3; i++) {
+			bvhNodes[nodeIndex].boundsMin[i] = boundsMin[i];
+			bvhNodes[nodeIndex].boundsMax[i] = boundsMax[i];
+		}
+
+		// Nodes At BVH_MAX_DEPTH Become Leaves Whatever Their Count, So Traversal Never Overflows Its Stack
+		if ((count <= BVH_LEAF_SIZE) || (depth >= BVH_MAX_DEPTH)) {
+			bvhNodes[nodeIndex].leftFirst = first;
+			bvhNodes[nodeIndex].count = count;
+			return;
+		}
+
+		// Split Along The Longest Axis Of Centroids
+		glm::vec3 extent = centroidMax - centroidMin;
+		int axis = 0;
+		if (extent.y > extent[axis]) {
+			axis = 1;
+		}
+		if (extent.z > extent[axis]) {
+			axis = 2;
+		}
+
+		// Midpoint Split, Falls Back To Median Split When Midpoint Leaves One Side Empty Or Tree Gets Too Deep
+		// Midpoint Is Only Taken While Median Splits Below It Can Still Reach Leaf Size Within BVH_MAX_DEPTH
+		int medianDepth = 0;
+		while ((medianDepth < BVH_MAX_DEPTH) && ((BVH_LEAF_SIZE << medianDepth) < count)) {
+			medianDepth++;
+		}
+		int mid = first;
+		if ((depth < BVH_MAX_MIDPOINT_DEPTH) && ((depth + 1 + medianDepth) <= BVH_MAX_DEPTH)) {
+			float split = 0.5f * (centroidMin[axis] + centroidMax[axis]);
+			auto it = std::partition(bvhPrimitives.begin() + first, bvhPrimitives.begin() + first + count,
+				[axis, split](const bvhPrimitive& primitive) { return primitive.centroid[axis] < split; });
+			mid = (int)(it - bvhPrimitives.begin());
+		}
+		if ((mid == first) || (mid == (first + count))) {
+			mid = first + count / 2;
+			std::nth_element(bvhPrimitives.begin() + first, bvhPrimitives.begin() + mid, bvhPrimitives.begin() + first + count,
+				[axis](const bvhPrimitive& a, const bvhPrimitive& b) { return a.centroid[axis] < b.centroid[axis]; });
+		}
+
+		// Children Are Stored Next To Each Other, So Only Index Of Left Child Is Needed
+		int leftIndex = (int)bvhNodes.size();
+		bvhNodes.push_back(bvhNode{});
+		bvhNodes.push_back(bvhNode{});
+		bvhNodes[nodeIndex].leftFirst = leftIndex;
+		bvhNodes[nodeIndex].count = 0;
+
+		SubdivideBVHNode(leftIndex, first, mid - first, depth + 1);
+		SubdivideBVHNode(leftIndex + 1, mid, first + count - mid, depth + 1);
+	}
+
+	void BuildBVH(std::vector<glm::ivec2>& bvhPrimitivesArray) {
+		// Builds BVH Over All Bounded Objects, Leaves Point Into The (Type, Index) List Of Primitives
+		bvhNodes.clear();
+		CollectBVHPrimitives();
+		if (bvhPrimitives.empty()) {
+			return;
+		}
+
+		bvhNodes.push_back(bvhNode{});
+		SubdivideBVHNode(0, 0, (int)bvhPrimitives.size(), 0);
+
+		for (int i = 0; i < bvhPrimitives.size(); i++) {
+			bvhPrimitivesArray.push_back(glm::ivec2(bvhPrimitives[i].type, bvhPrimitives[i].index));
+		}
+	}
+
+	int BuildSDFBVH(std::vector<glm::ivec2>& bvhPrimitivesArray) {
+		// SDF Bounding Boxes Get Their Own Tree, Appended After The Nodes And Primitives Of Objects
+		// Returns Index Of Its Root, Shader Tests Every Box When There Is None
+		if (sdfs.empty()) {
+			return -1;
+		}
+
+		int first = (int)bvhPrimitives.size();
+		for (int i = 0; i < sdfs.size(); i++) {
+			glm::vec3 halfSize = 0.5f * glm::vec3(sdfs[i].size[0], sdfs[i].size[1], sdfs[i].size[2]);
+			AddBVHPrimitive(glm::vec3(sdfs[i].pos[0], sdfs[i].pos[1], sdfs[i].pos[2]), halfSize, 5, i);
+		}
+
+		int root = (int)bvhNodes.size();
+		bvhNodes.push_back(bvhNode{});
+		SubdivideBVHNode(root, first, (int)sdfs.size(), 0);
+
+		for (int i = first; i < bvhPrimitives.size(); i++) {
+			bvhPrimitivesArray.push_back(glm::ivec2(bvhPrimitives[i].type, bvhPrimitives[i].index));
+		}
+		return root;
+	}
+
+	void SubdivideLightNode(std::vector<gpuLightNode>& nodes, std::vector<lightEmitter>& emitters, int nodeIndex, int parent, int first, int count) {
+		// Node Bounds Are The Sphere Around The Box Of Its Light Sources, Which Are Split At The Median Of The Longest Axis
+		// Parents Let Shader Walk Up From A Leaf To Find The Probability Of Picking It
+		glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+		glm::vec3 centroidMin = boundsMin;
+		glm::vec3 centroidMax = boundsMax;
+		float power = 0.0f;
+		for (int i = first; i < first + count; i++) {
+			boundsMin = glm::min(boundsMin, emitters[i].pos - emitters[i].radius);
+			boundsMax = glm::max(boundsMax, emitters[i].pos + emitters[i].radius);
+			centroidMin = glm::min(centroidMin, emitters[i].pos);
+			centroidMax = glm::max(centroidMax, emitters[i].pos);
+			power += emitters[i].power;
+		}
+		nodes[nodeIndex].center = 0.5f * (boundsMin + boundsMax);
+		nodes[nodeIndex].radius = 0.5f * glm::length(boundsMax - boundsMin);
+		nodes[nodeIndex].power = power;
+		nodes[nodeIndex].parent = parent;
+
+		if (count == 1) {
+			nodes[nodeIndex].leftFirst = emitters[first].index;
+			nodes[nodeIndex].count = 1;
+			return;
+		}
+
+		glm::vec3 extent = centroidMax - centroidMin;
+		int axis = 0;
+		if (extent.y > extent[axis]) {
+			axis = 1;
+		}
+		if (extent.z > extent[axis]) {
+			axis = 2;
+		}
+		int mid = first + count / 2;
+		std::nth_element(emitters.begin() + first, emitters.begin() + mid, emitters.begin() + first + count, [axis](const lightEmitter& a, const lightEmitter& b) {
+			return a.pos[axis] < b.pos[axis];
+		});
+
+		// Both Children Are Allocated Together, So Shader Finds The Right One Next To The Left One
+		int leftIndex = (int)nodes.size();
+		nodes.push_back(gpuLightNode{});
+		nodes.push_back(gpuLightNode{});
+		nodes[nodeIndex].leftFirst = leftIndex;
+		nodes[nodeIndex].count = 0;
+
+		SubdivideLightNode(nodes, emitters, leftIndex, nodeIndex, first, mid - first);
+		SubdivideLightNode(nodes, emitters, leftIndex + 1, nodeIndex, mid, first + count - mid);
+	}
+
+	std::vector<gpuLightNode> BuildLightBVH(std::vector<lightEmitter>& emitters, const std::vector<gpuLight>& lightsArray) {
+		// Power Of A Light Source Is Mean Of Emit Over Visible Wavelengths Times Area Of Disk Of Its Bounding Sphere
+		std::vector<gpuLightNode> nodes;
+		if (emitters.empty()) {
+			return nodes;
+		}
+
+		for (lightEmitter& emitter : emitters) {
+			glm::vec2 emission = ((emitter.lightID >= 0) && (emitter.lightID < (int)lightsArray.size())) ? lightsArray[emitter.lightID].emission : glm::vec2(5500.0f, 0.0f);
+			float temperature = std::max(emission.x, 0.0f);
+			float radiance = 0.0f;
+			if (temperature > 0.0f) {
+				for (int i = 0; i < 34; i++) {
+					radiance += BlackBodyRadiation((390.0f + 10.0f * (float)i) * 1e-9f, temperature) / BlackBodyRadiationPeak(temperature);
+				}
+				radiance *= std::max(emission.y, 0.0f) / 34.0f;
+			}
+			emitter.power = radiance * PI * emitter.radius * emitter.radius;
+		}
+
+		nodes.push_back(gpuLightNode{});
+		SubdivideLightNode(nodes, emitters, 0, -1, 0, (int)emitters.size());
+		return nodes;
+	}
+
 	void UpdateUniformBuffer() {
 		if (isUpdateUBO) {
-			std::array<float, 7> numObjects;
-			std::vector<float> objectsArray;
-			std::vector<float> sdfsArray;
-			std::vector<float> materialsArray;
-			std::vector<float> lightsArray;
-			std::vector<float> lightIDs;
-
+			std::vector<gpuSphere> spheresArray;
+			std::vector<gpuPlane> planesArray;
+			std::vector<gpuBox> boxesArray;
+			std::vector<gpuLens> lensesArray;
+			std::vector<gpuCyclide> cyclidesArray;
+			std::vector<gpuPolynomial> polynomialsArray;
+			std::vector<gpuRect> rectsArray;
+			std::vector<gpuSDF> sdfsArray;
+			std::vector<gpuHeightfield> heightfieldsArray;
+			std::vector<gpuMaterial> materialsArray;
+			std::vector<gpuLight> lightsArray;
+			std::vector<int> lightIDs;
+			std::vector<lightEmitter> emitters;
+			std::vector<glm::ivec2> bvhPrimitivesArray;
+
+			// Light IDs Are Indices Of The Emitting Objects In The Order Of numObjects
 			for (int i = 0; i < spheres.size(); i++) {
-				objectsArray.push_back(spheres[i].pos[0]);
-				objectsArray.push_back(spheres[i].pos[1]);
-				objectsArray.push_back(spheres[i].pos[2]);
-				objectsArray.push_back(spheres[i].radius);
-				objectsArray.push_back((float)spheres[i].materialID);
-				objectsArray.push_back((float)spheres[i].lightID);
+				gpuSphere object{};
+				object.pos = glm::vec3(spheres[i].pos[0], spheres[i].pos[1], spheres[i].pos[2]);
+				object.radius = spheres[i].radius;
+				object.materialID = spheres[i].materialID - 1;
+				object.lightID = spheres[i].lightID - 1;
+				spheresArray.push_back(object);
 				if (spheres[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, object.radius, 0.0f, object.lightID, (int)lightIDs.size()});
 					lightIDs.push_back(i);
 				}
 			}
 
 			for (int i = 0; i < planes.size(); i++) {
-				objectsArray.push_back(planes[i].pos[0]);
-				objectsArray.push_back(planes[i].pos[1]);
-				objectsArray.push_back(planes[i].pos[2]);
-				objectsArray.push_back((float)planes[i].materialID);
-				objectsArray.push_back((float)planes[i].lightID);
+				gpuPlane object{};
+				object.pos = glm::vec3(planes[i].pos[0], planes[i].pos[1], planes[i].pos[2]);
+				object.materialID = planes[i].materialID - 1;
+				object.lightID = planes[i].lightID - 1;
+				planesArray.push_back(object);
 				if (planes[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, 1e5f, 0.0f, object.lightID, (int)lightIDs.size()});
 					lightIDs.push_back(spheres.size() + i);
 				}
 			}
 
 			for (int i = 0; i < boxes.size(); i++) {
-				objectsArray.push_back(boxes[i].pos[0]);
-				objectsArray.push_back(boxes[i].pos[1]);
-				objectsArray.push_back(boxes[i].pos[2]);
-				objectsArray.push_back(boxes[i].rotation[0]);
-				objectsArray.push_back(boxes[i].rotation[1]);
-				objectsArray.push_back(boxes[i].rotation[2]);
-				objectsArray.push_back(boxes[i].size[0]);
-				objectsArray.push_back(boxes[i].size[1]);
-				objectsArray.push_back(boxes[i].size[2]);
-				objectsArray.push_back((float)boxes[i].materialID);
-				objectsArray.push_back((float)boxes[i].lightID);
+				gpuBox object{};
+				object.pos = glm::vec3(boxes[i].pos[0], boxes[i].pos[1], boxes[i].pos[2]);
+				object.size = glm::vec3(boxes[i].size[0], boxes[i].size[1], boxes[i].size[2]);
+				object.boundingRadius2 = 0.25f * glm::dot(object.size, object.size);
+				object.worldToLocal = glm::mat3x4(glm::transpose(RotationMatrix(glm::vec3(boxes[i].rotation[0], boxes[i].rotation[1], boxes[i].rotation[2]))));
+				object.materialID = boxes[i].materialID - 1;
+				object.lightID = boxes[i].lightID - 1;
+				boxesArray.push_back(object);
 				if (boxes[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, sqrt(object.boundingRadius2), 0.0f, object.lightID, (int)lightIDs.size()});
 					lightIDs.push_back(spheres.size() + planes.size() + i);
 				}
 			}
 
 			for (int i = 0; i < lenses.size(); i++) {
-				objectsArray.push_back(lenses[i].pos[0]);
-				objectsArray.push_back(lenses[i].pos[1]);
-				objectsArray.push_back(lenses[i].pos[2]);
-				objectsArray.push_back(lenses[i].rotation[0]);
-				objectsArray.push_back(lenses[i].rotation[1]);
-				objectsArray.push_back(lenses[i].rotation[2]);
-				objectsArray.push_back(lenses[i].radius);
-				objectsArray.push_back(lenses[i].focalLength);
-				objectsArray.push_back(lenses[i].thickness);
-				objectsArray.push_back((float)lenses[i].isConverging);
-				objectsArray.push_back((float)lenses[i].materialID);
-				objectsArray.push_back((float)lenses[i].lightID);
-				if (planes[i].lightID > 0) {
+				gpuLens object{};
+				object.pos = glm::vec3(lenses[i].pos[0], lenses[i].pos[1], lenses[i].pos[2]);
+				object.worldToLocal = glm::mat3x4(glm::transpose(RotationMatrix(glm::vec3(lenses[i].rotation[0], lenses[i].rotation[1], lenses[i].rotation[2]))));
+				// Slice Constants Of Lens, Same As SetupLens In Shader
+				// Thickness Of Lens Is Calculated By Using The Equation: thickness = 2(2f - sqrt(4f^2 - R^2))
+				float focalLength = lenses[i].focalLength;
+				float lensThicknessHalf = 2.0f * focalLength - sqrt(4.0f * focalLength * focalLength - lenses[i].radius * lenses[i].radius);
+				object.sliceRadius = 2.0f * focalLength;
+				object.sliceSize = lensThicknessHalf;
+				object.slicePos = 0.5f * (lenses[i].isConverging ? lenses[i].thickness : -lenses[i].thickness);
+				if (lenses[i].isConverging) {
+					object.slicePos += lensThicknessHalf;
+					object.boundingRadius2 = (lenses[i].radius * lenses[i].radius) + (0.25f * lenses[i].thickness * lenses[i].thickness);
+				} else {
+					float boundingRadius = 0.5f * lenses[i].thickness + lensThicknessHalf;
+					object.boundingRadius2 = boundingRadius * boundingRadius + lenses[i].radius * lenses[i].radius;
+				}
+				object.isConverging = lenses[i].isConverging ? 1 : 0;
+				object.materialID = lenses[i].materialID - 1;
+				object.lightID = lenses[i].lightID - 1;
+				lensesArray.push_back(object);
+				if (lenses[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, sqrt(object.boundingRadius2), 0.0f, object.lightID, (int)lightIDs.size()});
 					lightIDs.push_back(spheres.size() + planes.size() + boxes.size() + i);
 				}
 			}
 
 			for (int i = 0; i < cyclides.size(); i++) {
-				objectsArray.push_back(cyclides[i].pos[0]);
-				objectsArray.push_back(cyclides[i].pos[1]);
-				objectsArray.push_back(cyclides[i].pos[2]);
-				objectsArray.push_back(cyclides[i].rotation[0]);
-				objectsArray.push_back(cyclides[i].rotation[1]);
-				objectsArray.push_back(cyclides[i].rotation[2]);
-				objectsArray.push_back(cyclides[i].scale[0]);
-				objectsArray.push_back(cyclides[i].scale[1]);
-				objectsArray.push_back(cyclides[i].scale[2]);
-				objectsArray.push_back(cyclides[i].a);
-				objectsArray.push_back(cyclides[i].b);
-				objectsArray.push_back(cyclides[i].c);
-				objectsArray.push_back(cyclides[i].d);
-				objectsArray.push_back(cyclides[i].brad * cyclides[i].brad *
-					(glm::max(glm::max(cyclides[i].scale[0], cyclides[i].scale[1]), cyclides[i].scale[2]) *
-					glm::max(glm::max(cyclides[i].scale[0], cyclides[i].scale[1]), cyclides[i].scale[2])));
-				objectsArray.push_back((float)cyclides[i].materialID);
-				objectsArray.push_back((float)cyclides[i].lightID);
-				if (planes[i].lightID > 0) {
+				float maxScale = glm::max(glm::max(cyclides[i].scale[0], cyclides[i].scale[1]), cyclides[i].scale[2]);
+				gpuCyclide object{};
+				object.pos = glm::vec3(cyclides[i].pos[0], cyclides[i].pos[1], cyclides[i].pos[2]);
+				object.invScale = 1.0f / glm::vec3(cyclides[i].scale[0], cyclides[i].scale[1], cyclides[i].scale[2]);
+				object.worldToLocal = glm::mat3x4(glm::transpose(RotationMatrix(glm::vec3(cyclides[i].rotation[0], cyclides[i].rotation[1], cyclides[i].rotation[2]))));
+				object.a = cyclides[i].a;
+				object.b = cyclides[i].b;
+				object.c = cyclides[i].c;
+				object.d = cyclides[i].d;
+				// Squared Bounding Radius In World Space
+				object.brad = cyclides[i].brad * cyclides[i].brad * maxScale * maxScale;
+				object.materialID = cyclides[i].materialID - 1;
+				object.lightID = cyclides[i].lightID - 1;
+				CyclideLocalBounds(cyclides[i], object.boundsMin, object.boundsMax);
+				cyclidesArray.push_back(object);
+				if (cyclides[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, sqrt(object.brad), 0.0f, object.lightID, (int)lightIDs.size()});
 					lightIDs.push_back(spheres.size() + planes.size() + boxes.size() + lenses.size() + i);
 				}
 			}
 
-			numObjects[0] = (float)spheres.size();
-			numObjects[1] = (float)planes.size();
-			numObjects[2] = (float)boxes.size();
-			numObjects[3] = (float)lenses.size();
-			numObjects[4] = (float)cyclides.size();
-			numObjects[5] = (float)sdfs.size();
-			numObjects[6] = (float)lightIDs.size();
-
-			for (size_t i = 0; i < numObjects.size(); i++) {
-				ubo.numObjects[i] = numObjects[i];
+			for (int i = 0; i < polynomials.size(); i++) {
+				// Local Coordinates Are Rotated And Scaled From The Offset To Position, Which Is Left To Shader
+				glm::mat3 localFromWorld = glm::transpose(RotationMatrix(glm::vec3(polynomials[i].rotation[0], polynomials[i].rotation[1], polynomials[i].rotation[2])));
+				for (int j = 0; j < 3; j++) {
+					for (int k = 0; k < 3; k++) {
+						localFromWorld[k][j] /= polynomials[i].scale[j];
+					}
+				}
+				float maxScale = glm::max(glm::max(polynomials[i].scale[0], polynomials[i].scale[1]), polynomials[i].scale[2]);
+				gpuPolynomial object{};
+				object.pos = glm::vec3(polynomials[i].pos[0], polynomials[i].pos[1], polynomials[i].pos[2]);
+				object.boundingRadius2 = polynomials[i].brad * polynomials[i].brad * maxScale * maxScale;
+				object.materialID = polynomials[i].materialID - 1;
+				ExpandPolynomialRay(polynomials[i].coefficients, localFromWorld, object.terms);
+				polynomialsArray.push_back(object);
 			}
 
-			for (int i = 0; i < MAX_OBJECTS_SIZE; i++) {
-				if (objectsArray.size() > i) {
-					ubo.packedObjects[i] = objectsArray[i];
-				} else {
-					ubo.packedObjects[i] = 0.0f;
+			// Polynomials Never Emit, Light IDs Of Rects Still Count Them So That They Follow ObjectIDOffset In Shader
+			for (int i = 0; i < rects.size(); i++) {
+				gpuRect object{};
+				object.pos = glm::vec3(rects[i].pos[0], rects[i].pos[1], rects[i].pos[2]);
+				object.size = glm::vec2(rects[i].size[0], rects[i].size[1]);
+				object.boundingRadius2 = 0.25f * glm::dot(object.size, object.size);
+				object.worldToLocal = glm::mat3x4(glm::transpose(RotationMatrix(glm::vec3(rects[i].rotation[0], rects[i].rotation[1], rects[i].rotation[2]))));
+				object.materialID = rects[i].materialID - 1;
+				object.lightID = rects[i].lightID - 1;
+				rectsArray.push_back(object);
+				if (rects[i].lightID > 0) {
+					emitters.push_back(lightEmitter{object.pos, sqrt(object.boundingRadius2), 0.0f, object.lightID, (int)lightIDs.size()});
+					lightIDs.push_back(spheres.size() + planes.size() + boxes.size() + lenses.size() + cyclides.size() + polynomials.size() + i);
 				}
 			}
 
 			for (int i = 0; i < sdfs.size(); i++) {
-				sdfsArray.push_back(sdfs[i].pos[0]);
-				sdfsArray.push_back(sdfs[i].pos[1]);
-				sdfsArray.push_back(sdfs[i].pos[2]);
-				sdfsArray.push_back(sdfs[i].size[0]);
-				sdfsArray.push_back(sdfs[i].size[1]);
-				sdfsArray.push_back(sdfs[i].size[2]);
+				// SDFs Missing From Compute Pipelines Run Their Bytecode Instead
+				auto function = std::find(pipelineFunctions.begin(), pipelineFunctions.end(), sdfs[i].glsl);
+				auto codeOffsets = sdfCodeOffsets.find(sdfs[i].glsl);
+				gpuSDF object{};
+				object.pos = glm::vec3(sdfs[i].pos[0], sdfs[i].pos[1], sdfs[i].pos[2]);
+				object.size = glm::vec3(sdfs[i].size[0], sdfs[i].size[1], sdfs[i].size[2]);
+				object.functionID = (function != pipelineFunctions.end()) ? (int)(function - pipelineFunctions.begin()) : -1;
+				sdfMetadata metadata = SDFMetadata(sdfs[i]);
+				// Baked Distances Assume The Lipschitz Bound Holds Everywhere, Which Distance Estimators Don't Guarantee
+				object.bakeOffset = (isBakeSDF && !metadata.isDistanceEstimator) ? i * SDF_BAKE_CELLS : -1;
+				object.codeOffset = (codeOffsets != sdfCodeOffsets.end()) ? codeOffsets->second.x : -1;
+				object.materialCodeOffset = (codeOffsets != sdfCodeOffsets.end()) ? codeOffsets->second.y : -1;
+				object.stepScale = (metadata.lipschitz > 0.0f) ? 1.0f / metadata.lipschitz : 1.0f;
+				object.omegaMax = metadata.omegaMax;
+				object.omegaSpeed = metadata.omegaSpeed;
+				object.hitDistance = metadata.hitDistance;
+				object.isDistanceEstimator = metadata.isDistanceEstimator;
+				sdfsArray.push_back(object);
 			}
 
-			for (int i = 0; i < MAX_SDFS_SIZE; i++) {
-				if (sdfsArray.size() > i) {
-					ubo.packedSdfs[i] = sdfsArray[i];
-				} else {
-					ubo.packedSdfs[i] = 0.0f;
-				}
+			// Heights Are Only Baked Again When Heightfields Change
+			bool isHeightfieldBaked = isHeightfieldChanged;
+			if (isHeightfieldChanged) {
+				BakeHeightfields();
+				isHeightfieldChanged = false;
 			}
 
-			for (int i = 0; i < materials.size(); i++) {
-				materialsArray.push_back(materials[i].reflection[0]);
-				materialsArray.push_back(materials[i].reflection[1]);
-				materialsArray.push_back(materials[i].reflection[2]);
+			for (int i = 0; i < heightfields.size(); i++) {
+				gpuHeightfield object{};
+				object.pos = glm::vec3(heightfields[i].pos[0], heightfields[i].pos[1], heightfields[i].pos[2]);
+				object.size = glm::vec3(heightfields[i].size[0], heightfields[i].size[1], heightfields[i].size[2]);
+				object.resolution = heightfieldLayouts[i].x;
+				object.levels = heightfieldLayouts[i].y;
+				object.heightOffset = heightfieldLayouts[i].z;
+				object.mipOffset = heightfieldLayouts[i].z + (object.resolution + 1) * (object.resolution + 1);
+				object.materialID = heightfields[i].materialID - 1;
+				heightfieldsArray.push_back(object);
 			}
 
-			for (int i = 0; i < MAX_MATERIALS_SIZE; i++) {
-				if (materialsArray.size() > i) {
-					ubo.packedMaterials[i] = materialsArray[i];
-				} else {
-					ubo.packedMaterials[i] = 0.0f;
-				}
+			for (int i = 0; i < materials.size(); i++) {
+				gpuMaterial mat{};
+				mat.reflection = glm::vec3(materials[i].reflection[0], materials[i].reflection[1], materials[i].reflection[2]);
+				materialsArray.push_back(mat);
 			}
 
 			for (int i = 0; i < lights.size(); i++) {
-				lightsArray.push_back(lights[i].emission[0]);
-				lightsArray.push_back(lights[i].emission[1]);
+				gpuLight lt{};
+				lt.emission = glm::vec2(lights[i].emission[0], lights[i].emission[1]);
+				lightsArray.push_back(lt);
 			}
 
-			for (int i = 0; i < MAX_LIGHTS_SIZE; i++) {
-				if (lightsArray.size() > i) {
-					ubo.packedLights[i] = lightsArray[i];
-				} else {
-					ubo.packedLights[i] = 0.0f;
+			std::vector<gpuLightNode> lightNodesArray = BuildLightBVH(emitters, lightsArray);
+
+			// Light BVH Leaf Of Every Object ID Follows The Light Sources, Objects Which Aren't Light Sources Get -1
+			// Hits Of BRDF Samples Use It To Find The Probability Of Sampling The Same Direction Through Light Sources
+			int numLightSources = (int)lightIDs.size();
+			lightIDs.resize(numLightSources + spheres.size() + planes.size() + boxes.size() + lenses.size() + cyclides.size() + polynomials.size() + rects.size(), -1);
+			for (int i = 0; i < lightNodesArray.size(); i++) {
+				if (lightNodesArray[i].count == 1) {
+					lightIDs[numLightSources + lightIDs[lightNodesArray[i].leftFirst]] = i;
 				}
 			}
 
-			for (int i = 0; i < MAX_LIGHTIDS_SIZE; i++) {
-				if (lightIDs.size() > i) {
-					ubo.packedLightIDs[i] = lightIDs[i];
-				} else {
-					ubo.packedLightIDs[i] = 0.0f;
-				}
+			// Shader Falls Back To Iterating Over All The Objects If BVH Is Disabled
+			bvhNodes.clear();
+			bvhPrimitives.clear();
+			if (isUseBVH) {
+				BuildBVH(bvhPrimitivesArray);
+			}
+			int numObjectNodes = (int)bvhNodes.size();
+			ubo.sdfBVHRoot = isUseBVH ? BuildSDFBVH(bvhPrimitivesArray) : -1;
+
+			ubo.numObjects[0] = (int)spheres.size();
+			ubo.numObjects[1] = (int)planes.size();
+			ubo.numObjects[2] = (int)boxes.size();
+			ubo.numObjects[3] = (int)lenses.size();
+			ubo.numObjects[4] = (int)cyclides.size();
+			ubo.numObjects[5] = (int)sdfs.size();
+			ubo.numObjects[6] = numLightSources;
+			ubo.numObjects[7] = numObjectNodes;
+			ubo.numMaterials = (int)materials.size();
+			ubo.numLights = (int)lights.size();
+			ubo.numHeightfields = (int)heightfields.size();
+			ubo.numPolynomials = (int)polynomials.size();
+			ubo.numRects = (int)rects.size();
+
+			// CPU Renderer Reads The Arrays Directly
+			if (CPURENDER) {
+				cpuScene.ubo = ubo;
+				cpuScene.spheres = spheresArray;
+				cpuScene.planes = planesArray;
+				cpuScene.boxes = boxesArray;
+				cpuScene.lenses = lensesArray;
+				cpuScene.cyclides = cyclidesArray;
+				cpuScene.polynomials = polynomialsArray;
+				cpuScene.rects = rectsArray;
+				cpuScene.sdfs = sdfsArray;
+				cpuScene.heightfields = heightfieldsArray;
+				cpuScene.materials = materialsArray;
+				cpuScene.lights = lightsArray;
+				cpuScene.lightIDs = lightIDs;
+				cpuScene.bvhNodes = bvhNodes;
+				cpuScene.bvhPrimitives = bvhPrimitivesArray;
+				cpuScene.sdfCode = sdfCode;
+				cpuScene.heightfieldData = heightfieldData;
+				cpuScene.lightNodes = lightNodesArray;
+				isUpdateUBO = false;
+				return;
+			}
+
+			bool isRecreated = false;
+			isRecreated |= UploadSceneBuffer(0, spheresArray);
+			isRecreated |= UploadSceneBuffer(1, planesArray);
+			isRecreated |= UploadSceneBuffer(2, boxesArray);
+			isRecreated |= UploadSceneBuffer(3, lensesArray);
+			isRecreated |= UploadSceneBuffer(4, cyclidesArray);
+			isRecreated |= UploadSceneBuffer(5, sdfsArray);
+			isRecreated |= UploadSceneBuffer(6, materialsArray);
+			isRecreated |= UploadSceneBuffer(7, lightsArray);
+			isRecreated |= UploadSceneBuffer(8, lightIDs);
+			isRecreated |= UploadSceneBuffer(9, bvhNodes);
+			isRecreated |= UploadSceneBuffer(10, bvhPrimitivesArray);
+			isRecreated |= UploadSceneBuffer(11, sdfCode);
+			isRecreated |= UploadSceneBuffer(12, heightfieldsArray);
+			if (isHeightfieldBaked) {
+				isRecreated |= UploadSceneBuffer(13, heightfieldData);
+			}
+			isRecreated |= UploadSceneBuffer(14, polynomialsArray);
+			isRecreated |= UploadSceneBuffer(15, lightNodesArray);
+			isRecreated |= UploadSceneBuffer(16, rectsArray);
+
+			if (isRecreated) {
+				UpdateDescriptorSet();
 			}
 
 			for (size_t k = 0; k < MAX_FRAMES_IN_FLIGHT; k++) {
@@ -3831,29 +10899,283 @@ float sdfmaterial(in vec3 p)
 		pushConstant.lensThickness = camera.lensThickness;
 		pushConstant.lensDistance = camera.lensDistance;
 		pushConstant.tonemap = tonemap;
+		pushConstant.sampleIndex = 0;
+		pushConstant.bounce = 0;
+		pushConstant.isRaySorting = isRaySorting;
+		pushConstant.isCountMarchSteps = isCountMarchSteps;
+		pushConstant.isConePrepass = isConePrepass && !sdfs.empty();
+		pushConstant.isFootprintMarching = isFootprintMarching;
+		pushConstant.isCyclideIntervalTest = isCyclideIntervalTest;
+		pushConstant.samplerType = samplerType;
+		// Pixels Are Only Left Out Of Frames Accumulating Onto At Least ADAPTIVE_MIN_SAMPLES Samples
+		pushConstant.isAdaptive = isAdaptiveSampling && ((currentSamples - samplesPerFrame) >= ADAPTIVE_MIN_SAMPLES);
+		// Pixel Statistics Are Only Kept While Threshold Is Above Zero, Which Marks Adaptive Sampling As On Before Any Pixel Is Left Out
+		pushConstant.adaptiveThreshold = isAdaptiveSampling ? std::max(adaptiveThreshold, 0.0001f) : 0.0f;
+	}
+
+	void CleanUpPipelineBuild() {
+		// Build That Failed Has No Pipelines To Clean Up
+		try {
+			CleanUpComputePipelines(pipelineBuild.get().pipelines);
+		} catch (const std::exception&) {
+		}
 	}
 
 	void RecompileComputeShaders() {
-		vkDestroyPipeline(device, computePipeline, nullptr);
-		vkDestroyPipelineLayout(device, computePipelineLayout, nullptr);
+		// A Build Still Running In Background Is Outdated By This One
+		if (pipelineBuild.valid()) {
+			CleanUpPipelineBuild();
+		}
+
+		ReadComputeShader();
+		std::vector<std::string> functions;
+		SDFFunctionIDs(functions);
+		isPipelineBuildFailed = false;
+		try {
+			std::vector<uint32_t> spirv = CompileComputeShader(computeShaderCode, functions, isDualSDFNormals);
+			std::array<VkPipeline, KERNEL_STAGES_COUNT> pipelines = CreateComputePipelines(spirv, false);
+			CleanUpComputePipelines(computePipelines);
+			computePipelines = pipelines;
+			pipelineFunctions = functions;
+			pipelineSPIRV = spirv;
+			isPipelinesInterpreting = false;
+		} catch (const std::exception& error) {
+			// Offscreen Render Would Be Saved Without The SDFs, So It Stops Instead
+			if (OFFSCREENRENDER) {
+				throw;
+			}
+			std::cout << "Compute Shader Can't Be Recompiled, Previous Pipelines Are Kept: " << error.what() << std::endl;
+			isPipelineBuildFailed = true;
+		}
 
-		CreateComputePipeline();
+		// SDF Functions May Have Changed
+		isUpdateUBO = true;
+		isRebakeSDF = true;
+	}
+
+	bool IsSDFMissingFromPipelines() {
+		for (const sdf& object : sdfs) {
+			if (std::find(pipelineFunctions.begin(), pipelineFunctions.end(), object.glsl) == pipelineFunctions.end()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	sdfMetadata SDFMetadata(const sdf& object) {
+		return sdfMetadatas.count(object.glsl) ? sdfMetadatas[object.glsl] : ParseSDFMetadata(object.glsl);
+	}
+
+	void UpdateSDFMetadata() {
+		// Metadata Is Read Once Per SDF Function, Undeclared Lipschitz Bounds Are Estimated Over The Box Of Its First SDF
+		for (const sdf& object : sdfs) {
+			if (sdfMetadatas.count(object.glsl)) {
+				continue;
+			}
+			sdfMetadata metadata = ParseSDFMetadata(object.glsl);
+			if (metadata.lipschitz < 0.0f) {
+				metadata.lipschitz = 1.0f;
+				try {
+					std::vector<glm::ivec4> code;
+					int start = SDFBytecodeCompiler(object.glsl, computeShaderDefines).Compile("sdf", code);
+					float estimate = EstimateSDFLipschitz(code, start, glm::vec3(object.size[0], object.size[1], object.size[2]));
+					// Slopes Slightly Above 1 Are Errors Of Differences, Larger Ones Get A Margin For Points Between Samples
+					if (estimate > 1.05f) {
+						metadata.lipschitz = 1.25f * estimate;
+					}
+					std::cout << "Estimated SDF Lipschitz Bound: " << metadata.lipschitz << std::endl;
+				} catch (const std::runtime_error& error) {
+					std::cout << "SDF Lipschitz Bound Can't Be Estimated: " << error.what() << std::endl;
+				}
+			}
+			sdfMetadatas[object.glsl] = metadata;
+		}
+		isUpdateUBO = true;
+	}
+
+	void KeepMarchSteps(const std::string& change) {
+		// Steps Before A Change Are Kept, So Its Savings Can Be Seen Once Steps Are Counted Again
+		gpuMarchStats* marchStats = (gpuMarchStats*)marchStatsBuffer.mapped;
+		marchStepsBefore = isCountMarchSteps ? (float)((double)marchStats->marchSteps / std::max(marchStats->marchedRays, (uint64_t)1)) : -1.0f;
+		marchStepsChange = change;
+		isCountMarchSteps = true;
+	}
+
+	void ShrinkSDFBox(int id) {
+		// Declared Box Is Shrunk To Leaf Cells Of An Octree Over It That May Hold The Surface
+		try {
+			sdfMetadata metadata = sdfMetadatas.at(sdfs[id].glsl);
+			// Distance Estimators Can Overestimate Far From The Surface, Which Would Cull Cells Holding It
+			if (metadata.isDistanceEstimator) {
+				printf("SDF %i Box Kept, Distance Estimators Can't Shrink It \n", id + 1);
+				return;
+			}
+			std::vector<glm::ivec4> code;
+			int start = SDFBytecodeCompiler(sdfs[id].glsl, computeShaderDefines).Compile("sdf", code);
+			glm::vec3 size = glm::vec3(sdfs[id].size[0], sdfs[id].size[1], sdfs[id].size[2]);
+			glm::vec3 tightSize = 2.0f * TightSDFHalfSize(code, start, metadata, 0.5f * size);
+			for (int i = 0; i < 3; i++) {
+				sdfs[id].size[i] = tightSize[i];
+			}
+			printf("SDF %i Box Shrunk From %0.3fx%0.3fx%0.3f To %0.3fx%0.3fx%0.3f (%0.1f%% Of Volume) \n", id + 1, size.x, size.y, size.z, tightSize.x, tightSize.y, tightSize.z, 100.0f * (tightSize.x * tightSize.y * tightSize.z) / std::max(size.x * size.y * size.z, 1e-30f));
+		} catch (const std::exception& error) {
+			std::cout << "SDF Box Can't Be Shrunk: " << error.what() << std::endl;
+		}
+		isUpdateUBO = true;
+		isRebakeSDF = true;
+	}
+
+	void BakeHeightfields() {
+		// Heights And Mips Of Every Heightfield Are Packed Into One Array, Layouts Hold Resolution, Levels And Offset Of Heights
+		// Heightfields That Fail To Bake Are Left Flat
+		heightfieldData.clear();
+		heightfieldLayouts.clear();
+		for (heightfield& object : heightfields) {
+			int levels = (int)std::ceil(std::log2((double)glm::clamp(object.resolution, 1, HEIGHTFIELD_MAX_RESOLUTION)));
+			int resolution = 1 << levels;
+			std::vector<float> heights((resolution + 1) * (resolution + 1), 0.0f);
+			try {
+				if (!object.glsl.empty()) {
+					std::vector<glm::ivec4> code;
+					int start = SDFBytecodeCompiler(object.glsl, computeShaderDefines).Compile("sdf", code);
+					BakeSDFHeightfield(code, start, glm::vec3(object.size[0], object.size[1], object.size[2]), resolution, heights);
+				} else if (!object.raw.empty()) {
+					ResampleRawHeightfield(ReadFile(object.raw), object.size[1], resolution, heights);
+				}
+			} catch (const std::runtime_error& error) {
+				std::cout << "Heightfield Can't Be Baked: " << error.what() << std::endl;
+			}
+			std::vector<float> mips;
+			BuildHeightfieldMips(heights, resolution, mips);
+			heightfieldLayouts.push_back(glm::ivec3(resolution, levels, (int)heightfieldData.size()));
+			heightfieldData.insert(heightfieldData.end(), heights.begin(), heights.end());
+			heightfieldData.insert(heightfieldData.end(), mips.begin(), mips.end());
+		}
+	}
+
+	void CompileSDFBytecode() {
+		// SDFs Not In Compute Pipelines Are Compiled To Bytecode In Milliseconds And Interpreted Until Pipelines Catch Up
+		sdfCode.clear();
+		sdfCodeOffsets.clear();
+		for (const sdf& object : sdfs) {
+			if ((std::find(pipelineFunctions.begin(), pipelineFunctions.end(), object.glsl) != pipelineFunctions.end()) || sdfCodeOffsets.count(object.glsl)) {
+				continue;
+			}
+			try {
+				SDFBytecodeCompiler compiler(object.glsl, computeShaderDefines);
+				glm::ivec2 offsets;
+				offsets.x = compiler.Compile("sdf", sdfCode);
+				offsets.y = compiler.Compile("sdfmaterial", sdfCode);
+				sdfCodeOffsets[object.glsl] = offsets;
+			} catch (const std::runtime_error& error) {
+				// Only Compiling The Compute Shader Can Show This SDF
+				std::cout << "SDF Can't Be Interpreted: " << error.what() << std::endl;
+				isRecompile = true;
+			}
+		}
+		isUpdateUBO = true;
+	}
+
+	void StartComputePipelinesBuild() {
+		std::vector<std::string> functions;
+		SDFFunctionIDs(functions);
+		std::string code = computeShaderCode;
+		bool isDualSDF = isDualSDFNormals;
+		pipelineBuild = std::async(std::launch::async, [this, code, functions, isDualSDF]() {
+			ComputePipelineBuild build;
+			build.spirv = CompileComputeShader(code, functions, isDualSDF);
+			build.pipelines = CreateComputePipelines(build.spirv, false);
+			build.functions = functions;
+			return build;
+		});
+	}
+
+	void SwapComputePipelines() {
+		// Errors Of The Build Thread Are Rethrown By get, Previous Pipelines Are Kept Then
+		ComputePipelineBuild build;
+		try {
+			build = pipelineBuild.get();
+		} catch (const std::exception& error) {
+			std::cout << "Compute Pipelines Failed To Build, Previous Pipelines Are Kept: " << error.what() << std::endl;
+			isPipelineBuildFailed = true;
+			return;
+		}
+		CleanUpComputePipelines(computePipelines);
+		computePipelines = build.pipelines;
+		pipelineFunctions = build.functions;
+		pipelineSPIRV = build.spirv;
+		isPipelinesInterpreting = false;
+
+		// SDFs Changed While Building May Have Left The Pipelines, So Their Bytecode Is Needed Again
+		CompileSDFBytecode();
+	}
+
+	void SpecializeSDFInterpreter() {
+		// Only The Driver Compiles Pipelines Again, Which Is Much Quicker Than Building New Ones From GLSL
+		std::array<VkPipeline, KERNEL_STAGES_COUNT> pipelines = CreateComputePipelines(pipelineSPIRV, true);
+		CleanUpComputePipelines(computePipelines);
+		computePipelines = pipelines;
+		isPipelinesInterpreting = true;
 	}
 
 	void DrawFrame() {
-		if (isRecompile) {
+		if (isSDFChanged) {
+			UpdateSDFMetadata();
+			if (isShrinkSDFBoxes) {
+				for (int i = 0; i < sdfs.size(); i++) {
+					ShrinkSDFBox(i);
+				}
+			}
+			// Offscreen Renders Compile Every SDF Before Rendering Instead Of Interpreting Them
+			if (OFFSCREENRENDER) {
+				isRecompile |= IsSDFMissingFromPipelines();
+			} else {
+				CompileSDFBytecode();
+			}
+			isSDFChanged = false;
+			isPipelineBuildFailed = false;
+		}
+
+		bool isPipelineBuilt = pipelineBuild.valid() && (pipelineBuild.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+		bool isInterpreterNeeded = !isPipelinesInterpreting && IsSDFMissingFromPipelines();
+		if (isRecompile || isPipelineBuilt || isInterpreterNeeded) {
 			for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
 				vkWaitForFences(device, 1, &computeInFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 				currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 			}
-			RecompileComputeShaders();
-			isRecompile = false;
+			if (isRecompile) {
+				RecompileComputeShaders();
+				isRecompile = false;
+			} else if (isPipelineBuilt) {
+				SwapComputePipelines();
+			}
+			// SDFs Missing From Pipelines Are Interpreted Until The Build Running In Background Holds Them
+			if (!isPipelinesInterpreting && IsSDFMissingFromPipelines()) {
+				SpecializeSDFInterpreter();
+			}
 		} else {
 			vkWaitForFences(device, 1, &computeInFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 		}
 
+		if (!pipelineBuild.valid() && !isPipelineBuildFailed && IsSDFMissingFromPipelines()) {
+			StartComputePipelinesBuild();
+		}
+
+		ReadComputeTime();
 		UpdateUniformBuffer();
+		UpdateWavefrontBuffers();
+		UpdateConeTileBuffer();
+		UpdateAdaptiveBuffer();
 		UpdatePushConstant();
+		// Frames Of Adaptive Sampling Since The Accumulation Restarted, List Of Unconverged Pixels Is Rebuilt Every ADAPTIVE_UPDATE_FRAMES Of Them
+		adaptiveFrames = pushConstant.isAdaptive ? (adaptiveFrames + 1) : 0;
+		if (isRebakeSDF) {
+			BakeSDFs();
+		}
+		if (currentSamples <= samplesPerFrame) {
+			// March Statistics Are Counted Over Every Sample Since Last Reset
+			memset(marchStatsBuffer.mapped, 0, sizeof(gpuMarchStats));
+		}
 
 		if (isSaveRender) {
 		    SaveRender();
@@ -3962,6 +11284,257 @@ float sdfmaterial(in vec3 p)
 		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 	}
 
+	void CPUMainLoop() {
+		// Offscreen Render On CPU Threads, Neither Window Nor Device Is Created
+		std::cout << "Number Of Samples: ";
+		std::cin >> numSamples;
+		std::cout << "Number Of Samples Per Frame: ";
+		std::cin >> samplesPerFrame;
+		std::cout << "Path Length: ";
+		std::cin >> pathLength;
+		std::cout << "Number Of Threads(0 - All Cores): ";
+		std::cin >> numCPUThreads;
+		std::cout << "Ray Packets(0 - Scalar, 1 - Widest Supported): ";
+		std::cin >> cpuPacketWidth;
+		cpuPacketWidth = (cpuPacketWidth != 0) ? CPUPacketWidth() : 1;
+		std::cout << "Benchmark Packet Kernels(0 - Off, 1 - On): ";
+		std::cin >> isPacketBenchmark;
+		std::cout << "Shrink SDF Boxes(0 - Off, 1 - On): ";
+		std::cin >> isShrinkSDFBoxes;
+		std::cout << "SDF Marching(0 - Fixed, 1 - Footprint): ";
+		std::cin >> isFootprintMarching;
+		std::cout << "Cyclide Interval Test(0 - Off, 1 - On): ";
+		std::cin >> isCyclideIntervalTest;
+		std::cout << "Sampler(0 - PCG32, 1 - Sobol, 2 - Blue Noise): ";
+		std::cin >> samplerType;
+		std::cout << "Compare Samplers(0 - Off, 1 - On): ";
+		std::cin >> isSamplerComparison;
+		std::cout << "Adaptive Sampling(0 - Off, 1 - On): ";
+		std::cin >> isAdaptiveSampling;
+		if (isAdaptiveSampling) {
+			std::cout << "Target Relative Error: ";
+			std::cin >> adaptiveThreshold;
+		}
+		std::cout << "Time Budget(Seconds, 0 - None): ";
+		std::cin >> timeBudget;
+		isCountMarchSteps = true;
+		std::cout << "Camera Shot Index(1, 2, 3, ...): ";
+		std::cin >> cameraShotIndex;
+
+		if (numCPUThreads <= 0) {
+			numCPUThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+		}
+
+		std::vector<std::string> sceneDir = pfd::open_file("Load Scene", "", {"All Files", "*"}, pfd::opt::none).result();
+
+		if (sceneDir.empty()) {
+			throw std::runtime_error("No Scene Has Been Selected!");
+		} else {
+			scene = ReadJSON(sceneDir.at(0));
+		}
+
+		UpdateFromJSON();
+
+		// Every SDF Is Interpreted From Bytecode, Which Needs The Defines Of Shader
+		ReadComputeShader();
+		UpdateSDFMetadata();
+		if (isShrinkSDFBoxes) {
+			for (int i = 0; i < sdfs.size(); i++) {
+				ShrinkSDFBox(i);
+			}
+		}
+		CompileSDFBytecode();
+		if (isRecompile) {
+			throw std::runtime_error("Failed To Interpret SDFs On CPU!");
+		}
+		isSDFChanged = false;
+
+		UpdateUniformBuffer();
+		cpuScene.blueNoise = GenerateBlueNoise();
+		cpuTexels.assign(W * H, glm::vec4(0.0f));
+		cpuPixelStats.assign(W * H, gpuPixelStats{});
+
+		auto start = std::chrono::steady_clock::now();
+		auto end = start;
+		while (true) {
+			frame += samplesPerFrame;
+			currentSamples += samplesPerFrame;
+
+			UpdatePushConstant();
+			CPURenderer(cpuScene, pushConstant, cpuMarchStats.data(), cpuPacketWidth).Render(cpuTexels, cpuPixelStats, numCPUThreads);
+
+			auto prevEnd = end;
+			end = std::chrono::steady_clock::now();
+			double dtime = std::chrono::duration<double>(end - prevEnd).count();
+			double speed = (double)samplesPerFrame / dtime;
+			double timeElapsed = std::chrono::duration<double>(end - start).count();
+			double progress = RenderProgress(timeElapsed);
+			int percentage = std::min((int)(100.0 * progress), 100);
+			double timeRemaining = timeElapsed * std::max((1.0 / progress) - 1.0, 0.0);
+
+			std::string progressBar;
+			for (int i = 0; i < percentage; i++) {
+				progressBar.push_back((char)219);
+			}
+			for (int i = percentage; i < 100; i++) {
+				progressBar.push_back((char)32);
+			}
+
+			printf("Rendering: %i%%|%s| %i/%i [%0.1fs|%0.1fs, %0.3fSPP/s] \r", percentage, progressBar.data(), currentSamples, numSamples, timeElapsed, timeRemaining, speed);
+			// Pixels Are Checked Every Frame, As They Are When The Next Frame Picks Its Pixels
+			int unconvergedPixels = pushConstant.isAdaptive ? UnconvergedPixelsCount(cpuPixelStats.data()) : W * H;
+			const char* stopReason = RenderStopReason(timeElapsed, unconvergedPixels);
+			if (stopReason != nullptr) {
+				std::cout << std::endl;
+				printf("Rendering Completed In %0.3fs, %s. \n", timeElapsed, stopReason);
+				printf("Average Speed: %0.3fSPP/s (BVH %s, %i Nodes, CPU, %i Threads, %i Wide Packets) \n", (double)currentSamples / timeElapsed, isUseBVH ? "On" : "Off", ubo.numObjects[7], numCPUThreads, cpuPacketWidth);
+				PrintAdaptiveStats(cpuPixelStats.data());
+				printf("Average SDF Steps: %0.3f/Ray (Shrunk Boxes %s, %s Marching) \n", (double)cpuMarchStats[1] / std::max((uint64_t)cpuMarchStats[0], (uint64_t)1), isShrinkSDFBoxes ? "On" : "Off", isFootprintMarching ? "Footprint" : "Fixed");
+				printf("Rays Out Of SDF Steps: %0.3f%% \n", 100.0 * cpuMarchStats[2] / std::max((uint64_t)cpuMarchStats[0], (uint64_t)1));
+				printf("Quartic Solves: %0.3f%% Of Cyclide Tests, %0.3f%% Miss (Interval Test %s) \n", 100.0 * cpuMarchStats[4] / std::max((uint64_t)cpuMarchStats[3], (uint64_t)1), 100.0 * cpuMarchStats[5] / std::max((uint64_t)cpuMarchStats[4], (uint64_t)1), isCyclideIntervalTest ? "On" : "Off");
+				break;
+			}
+		}
+
+		if (isPacketBenchmark) {
+			PacketBenchmark();
+		}
+
+		if (isSamplerComparison) {
+			SamplerComparison();
+		}
+
+		SaveRender();
+	}
+
+	double RenderProgress(double timeElapsed) {
+		// Renders With A Time Budget Are As Far Along As Their Samples Or Their Time, Whichever Is Closer To Its End
+		double progress = (double)currentSamples / (double)numSamples;
+		if (timeBudget > 0.0f) {
+			progress = std::max(progress, timeElapsed / timeBudget);
+		}
+		return std::min(progress, 1.0);
+	}
+
+	const char* RenderStopReason(double timeElapsed, int unconvergedPixels) {
+		// Offscreen Renders Stop At Their Sample Count, Once Every Pixel Is Below The Target Error Or Once The Time Budget Is Spent
+		if (currentSamples >= numSamples) {
+			return "Samples Reached";
+		}
+		if (unconvergedPixels == 0) {
+			return "Every Pixel Converged";
+		}
+		if ((timeBudget > 0.0f) && (timeElapsed >= timeBudget)) {
+			return "Time Budget Spent";
+		}
+		return nullptr;
+	}
+
+	int UnconvergedPixelsCount(const gpuPixelStats* stats) {
+		int count = 0;
+		for (int i = 0; i < W * H; i++) {
+			count += !CPURenderer::IsPixelConverged(stats[i], adaptiveThreshold);
+		}
+		return count;
+	}
+
+	void PrintAdaptiveStats(const gpuPixelStats* stats) {
+		// Pixels Below The Target Error And Samples Every Pixel Took On Average
+		if (!isAdaptiveSampling) {
+			return;
+		}
+		double frames = 0.0;
+		for (int i = 0; i < W * H; i++) {
+			frames += stats[i].frames;
+		}
+		printf("Adaptive Sampling: %0.3f%% Of Pixels Below %0.4f Relative Error, %0.1f SPP On Average \n", 100.0 - 100.0 * UnconvergedPixelsCount(stats) / (W * H), adaptiveThreshold, samplesPerFrame * frames / (W * H));
+	}
+
+	void PacketBenchmark() {
+		// Kernels Run On One Thread, So Rays Per Second Are Per Core, Objects Missing From Scene Are Skipped
+		const char* kernelNames[PACKET_KERNEL_COUNT] = {"Sphere", "Plane", "Box", "AABB", "Cyclide", "BVH", "Analytic"};
+		int objectCounts[PACKET_KERNEL_COUNT] = {ubo.numObjects[0], ubo.numObjects[1], ubo.numObjects[2], ubo.numObjects[7], ubo.numObjects[4], ubo.numObjects[7], 1};
+		int width = CPUPacketWidth();
+		if (width == 1) {
+			std::cout << "Packet Kernels Are Not Supported On This CPU!" << std::endl;
+			return;
+		}
+		PushConstantValues benchmarkConstant = pushConstant;
+		benchmarkConstant.isCountMarchSteps = 0;
+		CPURenderer renderer(cpuScene, benchmarkConstant, cpuMarchStats.data(), width);
+		printf("Packet Kernels (%i Wide, Camera Rays Of %ix%i): \n", width, W, H);
+		for (int i = 0; i < PACKET_KERNEL_COUNT; i++) {
+			if (objectCounts[i] <= 0) {
+				continue;
+			}
+			double scalarSpeed = renderer.KernelThroughput(i, 1);
+			double packetSpeed = renderer.KernelThroughput(i, width);
+			printf("%s: %0.3fMRays/s/Core Scalar, %0.3fMRays/s/Core Packets, %0.2fx \n", kernelNames[i], scalarSpeed * 1e-6, packetSpeed * 1e-6, packetSpeed / scalarSpeed);
+		}
+	}
+
+	void SamplerComparison() {
+		// Finished Render Is The Reference, Its First Samples Are Shared By The Render Of Same Sampler
+		// So Sample Counts Only Go Up To A Sixteenth Of It, Where Shared Samples Barely Lower The Error
+		const char* samplerNames[SAMPLERS_COUNT] = {"PCG32", "Sobol", "Blue Noise"};
+		int maxSamples = std::max(numSamples / 16, 1);
+		std::vector<double> errors[SAMPLERS_COUNT];
+		for (int i = 0; i < SAMPLERS_COUNT; i++) {
+			std::vector<glm::vec4> texels(W * H, glm::vec4(0.0f));
+			std::vector<gpuPixelStats> stats(W * H);
+			PushConstantValues comparisonConstant = pushConstant;
+			comparisonConstant.samplesPerFrame = 1;
+			comparisonConstant.isCountMarchSteps = 0;
+			comparisonConstant.isAdaptive = 0;
+			comparisonConstant.adaptiveThreshold = 0.0f;
+			comparisonConstant.samplerType = i;
+			for (int k = 1; k <= maxSamples; k++) {
+				comparisonConstant.frame = k;
+				comparisonConstant.currentSamples = k;
+				CPURenderer(cpuScene, comparisonConstant, cpuMarchStats.data(), cpuPacketWidth).Render(texels, stats, numCPUThreads);
+				if ((k & (k - 1)) != 0) {
+					continue;
+				}
+				double sum = 0.0;
+				for (int j = 0; j < W * H; j++) {
+					glm::dvec3 difference = glm::dvec3(texels[j]) - glm::dvec3(cpuTexels[j]);
+					sum += glm::dot(difference, difference);
+				}
+				errors[i].push_back(std::sqrt(sum / (3.0 * W * H)));
+			}
+		}
+
+		// Gains Are Relative To PCG32
+		printf("RMSE Against %i SPP Render (%s): \n", numSamples, samplerNames[samplerType]);
+		for (int i = 0; i < (int)errors[0].size(); i++) {
+			printf("%i SPP: %0.6f %s", 1 << i, errors[0][i], samplerNames[0]);
+			for (int k = 1; k < SAMPLERS_COUNT; k++) {
+				printf(", %0.6f %s (%0.2fx)", errors[k][i], samplerNames[k], errors[0][i] / std::max(errors[k][i], 1e-12));
+			}
+			printf(" \n");
+		}
+		// Slope Of Least Squares Line Through Log Of Errors, Random Samples Converge At -0.5
+		for (int i = 0; i < SAMPLERS_COUNT; i++) {
+			int count = (int)errors[i].size();
+			if (count < 2) {
+				break;
+			}
+			double sumX = 0.0;
+			double sumY = 0.0;
+			double sumXX = 0.0;
+			double sumXY = 0.0;
+			for (int k = 0; k < count; k++) {
+				double x = (double)k * std::log(2.0);
+				double y = std::log(std::max(errors[i][k], 1e-12));
+				sumX += x;
+				sumY += y;
+				sumXX += x * x;
+				sumXY += x * y;
+			}
+			printf("%s Convergence: RMSE ~ SPP^%0.3f \n", samplerNames[i], (count * sumXY - sumX * sumY) / (count * sumXX - sumX * sumX));
+		}
+	}
+
     void MainLoop() {
 		double start = 0;
 		double end = 0;
@@ -3974,6 +11547,34 @@ float sdfmaterial(in vec3 p)
 			std::cin >> samplesPerFrame;
 			std::cout << "Path Length: ";
 			std::cin >> pathLength;
+			std::cout << "Wavefront Mode(0 - Megakernel, 1 - Wavefront): ";
+			std::cin >> isWavefront;
+			if (isWavefront) {
+				std::cout << "Sort Rays(0 - Off, 1 - On): ";
+				std::cin >> isRaySorting;
+			}
+			std::cout << "Bake SDFs(0 - Off, 1 - On): ";
+			std::cin >> isBakeSDF;
+			std::cout << "SDF Normals(0 - Tetrahedral, 1 - Dual Numbers): ";
+			std::cin >> isDualSDFNormals;
+			std::cout << "Shrink SDF Boxes(0 - Off, 1 - On): ";
+			std::cin >> isShrinkSDFBoxes;
+			std::cout << "SDF Marching(0 - Fixed, 1 - Footprint): ";
+			std::cin >> isFootprintMarching;
+			std::cout << "Cyclide Interval Test(0 - Off, 1 - On): ";
+			std::cin >> isCyclideIntervalTest;
+			std::cout << "Sampler(0 - PCG32, 1 - Sobol, 2 - Blue Noise): ";
+			std::cin >> samplerType;
+			std::cout << "Adaptive Sampling(0 - Off, 1 - On): ";
+			std::cin >> isAdaptiveSampling;
+			if (isAdaptiveSampling) {
+				std::cout << "Target Relative Error: ";
+				std::cin >> adaptiveThreshold;
+			}
+			std::cout << "Time Budget(Seconds, 0 - None): ";
+			std::cin >> timeBudget;
+			// Steps Per Ray Are Always Reported After Offscreen Render
+			isCountMarchSteps = true;
 			std::cout << "Camera Shot Index(1, 2, 3, ...): ";
 			std::cin >> cameraShotIndex;
 
@@ -4055,7 +11656,7 @@ float sdfmaterial(in vec3 p)
 				double dtime = end - prevEnd;
 				double speed = (double)samplesPerFrame / dtime;
 				double timeElapsed = end - start;
-				double progress = (double)currentSamples / (double)numSamples;
+				double progress = RenderProgress(timeElapsed);
 				int percentage = (int)(100.0 * progress);
 				double timeRemaining = timeElapsed * ((1.0 / progress) - 1.0);
 
@@ -4068,9 +11669,21 @@ float sdfmaterial(in vec3 p)
 				}
 
 				printf("Rendering: %i%%|%s| %i/%i [%0.1fs|%0.1fs, %0.3fSPP/s] \r", percentage, progressBar.data(), currentSamples, numSamples, timeElapsed, timeRemaining, speed);
-				if (currentSamples >= numSamples) {
+				int unconvergedPixels = IsAdaptiveUpdateFrame() ? ActivePixelsCount() : W * H;
+				const char* stopReason = RenderStopReason(timeElapsed, unconvergedPixels);
+				if (stopReason != nullptr) {
+					vkDeviceWaitIdle(device);
 					std::cout << std::endl;
-					printf("Rendering Completed In %0.3fs. \n", timeElapsed);
+					printf("Rendering Completed In %0.3fs, %s. \n", timeElapsed, stopReason);
+					printf("Average Speed: %0.3fSPP/s (BVH %s, %i Nodes, %s) \n", (double)currentSamples / timeElapsed, isUseBVH ? "On" : "Off", ubo.numObjects[7], isWavefront ? (isRaySorting ? "Wavefront, Sorted Rays" : "Wavefront") : "Megakernel");
+					if (isAdaptiveSampling) {
+						PrintAdaptiveStats(ReadAdaptiveStats().data());
+					}
+					printf("Average GPU Time: %0.3fms/Frame \n", totalComputeTime / std::max(timedFrames, 1));
+					gpuMarchStats* marchStats = (gpuMarchStats*)marchStatsBuffer.mapped;
+					printf("Average SDF Steps: %0.3f/Ray (Baked SDFs %s, Shrunk Boxes %s, %s Marching) \n", (double)marchStats->marchSteps / std::max(marchStats->marchedRays, (uint64_t)1), isBakeSDF ? "On" : "Off", isShrinkSDFBoxes ? "On" : "Off", isFootprintMarching ? "Footprint" : "Fixed");
+					printf("Rays Out Of SDF Steps: %0.3f%% \n", 100.0 * marchStats->exhaustedRays / std::max(marchStats->marchedRays, (uint64_t)1));
+					printf("Quartic Solves: %0.3f%% Of Cyclide Tests, %0.3f%% Miss (Interval Test %s) \n", 100.0 * marchStats->quarticSolves / std::max(marchStats->cyclideTests, (uint64_t)1), 100.0 * marchStats->quarticMisses / std::max(marchStats->quarticSolves, (uint64_t)1), isCyclideIntervalTest ? "On" : "Off");
 					break;
 				}
 			}
@@ -4087,6 +11700,11 @@ float sdfmaterial(in vec3 p)
 
 		vkDeviceWaitIdle(device);
 
+		// Build Running In Background Still Uses glslang And The Device
+		if (pipelineBuild.valid()) {
+			CleanUpPipelineBuild();
+		}
+
 		if (OFFSCREENRENDER) {
 		    SaveRender();
 		}
@@ -4107,8 +11725,22 @@ float sdfmaterial(in vec3 p)
 		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
 			vkDestroyBuffer(device, uniformBuffers[i], nullptr);
 			vkFreeMemory(device, uniformBuffersMemory[i], nullptr);
+
+			for (size_t k = 0; k < SCENE_BUFFERS_COUNT; k++) {
+				CleanUpStorageBuffer(sceneBuffers[i][k]);
+			}
 		}
 
+		vkDestroyBuffer(device, CIEXYZ1931Buffer, nullptr);
+		vkFreeMemory(device, CIEXYZ1931BufferMemory, nullptr);
+		vkDestroyBuffer(device, blueNoiseBuffer, nullptr);
+		vkFreeMemory(device, blueNoiseBufferMemory, nullptr);
+
+		CleanUpWavefrontBuffers();
+		CleanUpSDFBakeBuffers();
+		CleanUpConeTileBuffer();
+		CleanUpAdaptiveBuffer();
+
 		if (!OFFSCREENRENDER) {
 			vkDestroyDescriptorPool(device, imguiDescriptorPool, nullptr);
 		}
@@ -4136,7 +11768,11 @@ float sdfmaterial(in vec3 p)
 
 		vkDestroyCommandPool(device, commandPool, nullptr);
 
-		vkDestroyPipeline(device, computePipeline, nullptr);
+		if (timestampQueryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device, timestampQueryPool, nullptr);
+		}
+
+		CleanUpComputePipelines(computePipelines);
 		if (!OFFSCREENRENDER) {
 		    vkDestroyPipeline(device, graphicsPipeline, nullptr);
 		}